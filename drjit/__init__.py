@@ -1153,6 +1153,167 @@ def isolate_grad(when=True):
     return detail.ADContextManager(detail.ADScope.Isolate, [])
 
 
+def _nbytes(arg) -> int:
+    """Return the storage size of the Dr.Jit arrays within a PyTree"""
+    if is_array_v(arg):
+        if is_tensor_v(arg):
+            return _nbytes(arg.array)
+        elif depth_v(arg) == 1:
+            return width(arg) * itemsize_v(arg)
+        else:
+            return sum(_nbytes(v) for v in arg)
+    elif isinstance(arg, (list, tuple)):
+        return sum(_nbytes(v) for v in arg)
+    elif isinstance(arg, dict):
+        return sum(_nbytes(v) for v in arg.values())
+
+    desc = getattr(type(arg), 'DRJIT_STRUCT', None)
+    if isinstance(desc, dict):
+        return sum(_nbytes(getattr(arg, k)) for k in desc)
+
+    return 0
+
+
+class _CheckpointOp(CustomOp):
+    """Implementation detail of the function drjit.checkpoint()"""
+    def eval(self, func, args, kwargs):
+        # The inputs are detached, hence no intermediates are recorded
+        self.func, self.args, self.kwargs = func, args, kwargs
+        return func(*args, **kwargs)
+
+    def recompute(self):
+        # Re-run the function on fresh differentiable copies of the inputs
+        args, kwargs = detach(self.args), detach(self.kwargs)
+        enable_grad(args, kwargs)
+        return args, kwargs
+
+    def forward(self):
+        args, kwargs = self.recompute()
+        set_grad(args, self.grad_in('args'))
+        set_grad(kwargs, self.grad_in('kwargs'))
+        output = self.func(*args, **kwargs)
+        self.set_grad_out(forward_to(output, ADFlag.Default | ADFlag.AllowNoGrad))
+
+    def backward(self):
+        args, kwargs = self.recompute()
+        output = self.func(*args, **kwargs)
+        set_grad(output, self.grad_out())
+        enqueue(ADMode.Backward, output)
+        traverse(ADMode.Backward)
+        self.set_grad_in('args', grad(args))
+        self.set_grad_in('kwargs', grad(kwargs))
+
+    def name(self):
+        return f"checkpoint({getattr(self.func, '__name__', '?')})"
+
+
+def checkpoint(f=None, *, min_bytes: Optional[int] = None,
+               budget: Optional[int] = None, when: bool = True):
+    """
+    Decorator to trade computation for memory in differentiable programs
+    via *checkpointing* (also known as *rematerialization*).
+
+    When differentiating a long program in reverse mode, Dr.Jit must keep the
+    intermediate values needed to compute derivatives alive until
+    :py:func:`drjit.backward` or :py:func:`drjit.traverse` processes them.
+    Decorating a function with :py:func:`@dr.checkpoint <checkpoint>` changes
+    this behavior: the function runs without recording any intermediate
+    steps, and its body is evaluated a second time when derivatives are
+    propagated through it.
+
+    .. code-block:: python
+
+       @dr.checkpoint
+       def step(x, y):
+           return ... # Long computation with many temporaries
+
+       z = step(x, y) # The AD graph only contains a single node 'x,y -> z'
+       dr.backward(z) # Re-runs 'step()' to propagate derivatives
+
+    The implementation builds on :py:func:`drjit.custom`, and forward-mode
+    derivatives are supported as well. The function must be *pure*: all
+    differentiable inputs must be provided via (possibly nested :ref:`PyTree
+    <pytrees>`) arguments, since derivatives with respect to variables captured
+    by closures are not tracked.
+
+    Recomputation only pays off when the function creates substantial
+    temporaries. The ``min_bytes`` parameter can be used to decorate functions
+    liberally and only checkpoint large calls: calls whose array arguments
+    occupy fewer than ``min_bytes`` bytes run normally and record their
+    intermediate steps on the AD graph.
+
+    .. code-block:: python
+
+       @dr.checkpoint(min_bytes=256 * 1024**2)
+       def step(x):
+           ...
+
+    Alternatively, the ``budget`` parameter places checkpoints automatically
+    based on the memory retained by the AD graph (as estimated by
+    :py:func:`drjit.detail.ad_graph_bytes`). A call runs normally if the
+    current graph plus the growth caused by the previous normal call of the
+    same function fits within ``budget`` bytes, and it is checkpointed
+    otherwise. In a loop calling ``step()``, the first iterations therefore
+    record their intermediate steps until the budget is exhausted, and the
+    remaining ones are recomputed during the backward pass. The estimate
+    visits every edge of the AD graph, which adds a small cost to each call.
+
+    .. code-block:: python
+
+       @dr.checkpoint(budget=2 * 1024**3)
+       def step(x):
+           ...
+
+    Args:
+        f (Callable): The function to be checkpointed.
+
+        min_bytes (Optional[int]): Minimum combined size (in bytes) of the
+          array arguments that enables checkpointing. The default value
+          ``None`` checkpoints every call.
+
+        budget (Optional[int]): Memory budget (in bytes) of the AD graph, above
+          which calls are checkpointed. The default value ``None`` disables
+          this policy.
+
+        when (bool): Optional keyword argument that can be specified to turn the
+          decorator into a no-op via ``when=False``. The default value is
+          ``when=True``.
+    """
+
+    def decorator(f):
+        import functools
+
+        # Growth of the AD graph caused by the last call that was not
+        # checkpointed (used by the 'budget' policy)
+        footprint = 0
+
+        @functools.wraps(f)
+        def wrapper(*args, **kwargs):
+            nonlocal footprint
+
+            if not when or not grad_enabled(args, kwargs):
+                return f(*args, **kwargs)
+
+            if min_bytes is not None and _nbytes((args, kwargs)) < min_bytes:
+                return f(*args, **kwargs)
+
+            if budget is not None:
+                before = detail.ad_graph_bytes()
+                if before + footprint <= budget:
+                    result = f(*args, **kwargs)
+                    footprint = max(detail.ad_graph_bytes() - before, 0)
+                    return result
+
+            return custom(_CheckpointOp, f, args, kwargs)
+
+        return wrapper
+
+    if f is None:
+        return decorator
+    else:
+        return decorator(f)
+
+
 # -------------------------------------------------------------------
 #      Miscellaneous
 # -------------------------------------------------------------------
@@ -1657,8 +1818,35 @@ class _ResampleOp(CustomOp):
             self.resampler.resample_bwd(grad_out, self.stride)
         )
 
+class _ResampleFusedOp(CustomOp):
+    """Implementation detail of the function drjit.resample()"""
+    def eval(self, resamplers, source, shape, strides):
+        self.resamplers, self.shape, self.strides = resamplers, shape, strides
+        return type(source)(detail.resample_fused_fwd(detach(source, False), resamplers, shape))
+
+    def forward(self):
+        grad_source = detach(self.grad_in('source'), False)
+        self.set_grad_out(
+            detail.resample_fused_fwd(grad_source, self.resamplers, self.shape)
+        )
+
+    def backward(self):
+        # A fused backward pass would scatter-add into the source once per
+        # tap of the combined filter. Undo the axes one at a time instead,
+        # which matches the cost of the unfused path.
+        grad = detach(self.grad_out(), False)
+        for resampler, stride in zip(self.resamplers, self.strides):
+            if resampler is not None:
+                grad = resampler.resample_bwd(grad, stride)
+
+        self.set_grad_in('source', grad)
+
 _resample_cache = {}
 
+# Fuse the resampling steps of JIT arrays into a single kernel when the
+# combined filter footprint involves at most this many taps
+_resample_fused_max_taps = 64
+
 def resample(
     source: ArrayT,
     shape: Sequence[int],
@@ -1673,7 +1861,11 @@ def resample(
     specified set of axes. Given an input array (``source``) and target shape
     (``shape``), it returns a compatible array of the specified configuration.
     This is implemented using a sequence of successive 1D resampling steps for
-    each mismatched axis.
+    each mismatched axis. On JIT backends, these steps are fused into a single
+    kernel when the combined filter footprint is small; the derivative is
+    still propagated one axis at a time. Non-JIT arrays are resampled along
+    all axes within one parallel loop that streams tiles through the
+    per-axis filters without storing intermediate arrays.
 
     Example usage:
 
@@ -1767,6 +1959,7 @@ def resample(
             "drjit.resample(): 'source' and 'shape' must have the same number of axes."
         )
 
+    resamplers = [None] * ndim
     for i in reversed(range(ndim)):
         source_res = source_shape[i]
         target_res = shape[i]
@@ -1787,10 +1980,33 @@ def resample(
             )
             _resample_cache[key] = resampler
 
-        value = custom(_ResampleOp,
-            resampler=resampler,
+        resamplers[i] = resampler
+
+    # On JIT backends, resample all axes within a single kernel that directly
+    # reads the contributing source elements. This avoids intermediate
+    # arrays, but its cost grows with the product of per-axis filter sizes.
+    # The CPU implementation streams tiles through the per-axis filters,
+    # hence its cost only grows with their sum.
+    active = [r for r in resamplers if r is not None]
+    taps = 1
+    for r in active:
+        taps *= r.taps
+
+    if len(active) > 1 and (not is_jit_v(tp) or taps <= _resample_fused_max_taps):
+        value = custom(_ResampleFusedOp,
+            resamplers=resamplers,
             source=value,
-            stride=strides[i])
+            shape=list(source_shape),
+            strides=strides)
+    else:
+        for i in reversed(range(ndim)):
+            if resamplers[i] is None:
+                continue
+
+            value = custom(_ResampleOp,
+                resampler=resamplers[i],
+                source=value,
+                stride=strides[i])
 
     if is_tensor_v(tp):
         return tp(value, shape)
@@ -2347,6 +2563,7 @@ def freeze(
     *,
     state_fn: Optional[Callable],
     limit: Optional[int] = None,
+    limit_bytes: Optional[int] = None,
     warn_after: int = 10,
     backend: Optional[JitBackend] = None,
     auto_opaque: bool = True,
@@ -2361,6 +2578,7 @@ def freeze(
     *,
     state_fn: Optional[Callable] = None,
     limit: Optional[int] = None,
+    limit_bytes: Optional[int] = None,
     warn_after: int = 10,
     backend: Optional[JitBackend] = None,
     auto_opaque: bool = True,
@@ -2374,6 +2592,7 @@ def freeze(
     *,
     state_fn: Optional[Callable] = None,
     limit: Optional[int] = None,
+    limit_bytes: Optional[int] = None,
     warn_after: int = 10,
     backend: Optional[JitBackend] = None,
     auto_opaque: bool = True,
@@ -2483,12 +2702,25 @@ def freeze(
       configuration requires device memory, which can become problematic. Set the
       ``limit=`` parameter to enable a LRU cache. This is useful when calls to a
       function are mostly compatible but require occasional re-tracing.
+      Alternatively, the ``limit_bytes=`` parameter bounds the total estimated
+      memory footprint of the cached recordings. Per-recording statistics
+      (number of replays, record/replay time, estimated size) can be queried
+      via the ``recording_stats()`` method of the frozen function.
 
     Args:
         limit (Optional[int]): An optional integer specifying the maximum number of
           stored configurations. Once this limit is reached, incompatible calls
           requiring re-tracing will cause the last used configuration to be dropped.
 
+        limit_bytes (Optional[int]): An optional bound on the total estimated size
+          (in bytes) of the stored configurations. The size of a configuration
+          is estimated by the total size of the output and modified input
+          arrays allocated by each replay, plus the host memory of its input
+          and output layouts (the compiled kernels are not included). Once
+          exceeded, configurations that are large and rarely replayed are
+          dropped first (GreedyDual-Size-Frequency policy). The most recent
+          configuration is always kept.
+
         warn_after (int): When the number of re-tracing steps exceeds this value,
           Dr.Jit will generate a warning that explains which variables changed
           between calls to the function.
@@ -2514,6 +2746,7 @@ def freeze(
     """
 
     limit = limit if limit is not None else -1
+    limit_bytes = limit_bytes if limit_bytes is not None else -1
     backend = backend if backend is not None else JitBackend.Invalid
 
     def decorator(f):
@@ -2542,7 +2775,7 @@ def freeze(
             def __init__(self, f) -> None:
                 self.f = f
                 self.frozen = detail.FrozenFunction(
-                    inner, limit, warn_after, backend, auto_opaque
+                    inner, limit, warn_after, backend, auto_opaque, limit_bytes
                 )
                 self.enabled = enabled
 
@@ -2584,6 +2817,25 @@ def freeze(
                 """
                 return self.frozen.n_cached_recordings
 
+            @property
+            def cache_bytes(self):
+                """
+                Total estimated size (in bytes) of the recordings currently
+                cached, see the ``limit_bytes`` argument.
+                """
+                return self.frozen.cache_bytes
+
+            def recording_stats(self):
+                """
+                Returns a list with one dictionary per cached recording. Each
+                dictionary contains the number of replays (``n_replays``), the
+                total time in seconds spent recording (``record_time``) and
+                replaying (``replay_time``), the estimated size in bytes
+                (``size_bytes``), and the call index of the last use
+                (``last_used``).
+                """
+                return self.frozen.recording_stats()
+
             def clear(self):
                 """
                 Clears the recordings of the frozen function, and resets the
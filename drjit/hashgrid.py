@@ -347,39 +347,56 @@ class HashEncoding:
     def _acc_features(
         self,
         level_i: int,
-        weight: dr.ArrayBase,
-        index: dr.ArrayBase,
+        weights: List[dr.ArrayBase],
+        indices: List[dr.ArrayBase],
         values: List[dr.ArrayBase],
         active: bool | dr.ArrayBase,
     ):
         """
-        Accumulates the ``self.num_features`` features into ``values`` at the given
-        index. This function tries to use packet gather operations if possible,
-        to improve the performance of the backward pass, as atomic packet scatters
-        perform better than their non packeted counterparts for float16 types.
+        Accumulates the ``self.num_features`` features of all vertices of a
+        level into ``values``, given the interpolation weight and index of each
+        vertex.
+
+        On JIT backends, the vertices are blended by a
+        :py:func:`drjit.gather_footprint()` operation, which records one AD
+        node per level instead of one per vertex and feature. The generated
+        kernel is unchanged: it still performs one packet gather per vertex
+        and level, and one packet scatter-addition per vertex and level in
+        the backward pass. Otherwise, this function falls back to separate
+        packet gathers and multiply-adds per vertex.
         """
 
         if self.smooth_weight_gradients:
-            weight_smooth = cosine_ramp(weight)
-            weight = weight + self.smooth_weight_lambda * (
-                weight_smooth - dr.detach(weight_smooth)
-            )
-
-        v = dr.gather(
-            self.StorageFloatXf,
-            self.data,
-            index,
-            active,
-            shape=(self.n_features_per_level, dr.width(index)),
-        )
+            def smooth(weight):
+                weight_smooth = cosine_ramp(weight)
+                return weight + self.smooth_weight_lambda * (
+                    weight_smooth - dr.detach(weight_smooth)
+                )
 
-        for k in range(0, self.n_features_per_level):
-            values[level_i * self.n_features_per_level + k] = dr.fma(
-                v[k],
-                self.StorageFloat(weight),
-                values[level_i * self.n_features_per_level + k],
+            weights = [smooth(w) for w in weights]
+
+        weights = [self.StorageFloat(w) for w in weights]
+        n = self.n_features_per_level
+        base = level_i * n
+
+        if dr.is_jit_v(self.data) and (n & (n - 1)) == 0:
+            v = dr.gather_footprint(self.data, indices, weights, n, active)
+            for k in range(n):
+                values[base + k] = values[base + k] + v[k]
+            return
+
+        for weight, index in zip(weights, indices):
+            v = dr.gather(
+                self.StorageFloatXf,
+                self.data,
+                index,
+                active,
+                shape=(n, dr.width(index)),
             )
 
+            for k in range(n):
+                values[base + k] = dr.fma(v[k], weight, values[base + k])
+
     def indexing_function(self, key: dr.ArrayBase, level_i: int) -> dr.ArrayBase:
         """
         Given a key i.e. a D-dimensional integer vector identifying a vertex
@@ -524,13 +541,14 @@ class HashGridEncoding(HashEncoding):
             w1 = pos - pos0
             w0 = 1.0 - w1
 
+            weights, indices = [], []
             for offset in grid_offsets:
                 pos_grid = pos0 + offset
                 weight = dr.select(offset == 0, w0, w1)
-                weight = dr.prod(weight, axis=0)
+                weights.append(dr.prod(weight, axis=0))
+                indices.append(self.indexing_function(pos_grid, level_i))
 
-                index = self.indexing_function(pos_grid, level_i)
-                self._acc_features(level_i, weight, index, out_values, active)
+            self._acc_features(level_i, weights, indices, out_values, active)
 
         return self.StorageFloatXf(*out_values) & active
 
@@ -724,14 +742,14 @@ class PermutoEncoding(HashEncoding):
             )
 
             # ---- Accumulate features for each offset vector
+            indices = []
             for rank in range(self.dimension + 1):
-                offset = grid_offsets[rank]
+                pos_grid = base + grid_offsets[rank]
+                indices.append(self.indexing_function(pos_grid, level_i))
 
-                pos_grid = base + offset
-                weight = weights[rank]
-
-                index = self.indexing_function(pos_grid, level_i)
-                self._acc_features(level_i, weight, index, out_values, active)
+            self._acc_features(
+                level_i, list(weights), indices, out_values, active
+            )
 
         return self.StorageFloatXf(*out_values) & active
 
@@ -123,6 +123,18 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
     # Promote half-precision variables to use single precision internal storage?
     promote_fp16: bool
 
+    # Restrict updates to gradient blocks touched by gathers (or None)
+    grad_block_size: Optional[int]
+
+    # Only read and write entries with a nonzero gradient?
+    lazy: bool
+
+    # Optional gradient scaler that step() routes through
+    grad_scaler: Optional["GradScaler"]
+
+    # Evaluated half precision copies of promoted parameters
+    fp16_cache: Dict[str, dr.ArrayBase]
+
     # Maps the parameter name to a tuple containing
     # - the current parameter value
     # - whether the parameter was promoted to single precision
@@ -142,6 +154,9 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
         *,
         mask_updates: bool = False,
         promote_fp16: bool = True,
+        grad_block_size: Optional[int] = None,
+        lazy: bool = False,
+        grad_scaler: Optional["GradScaler"] = None,
     ):
         """
         Create an empty Optimizer object with the learning rate ``lr`` and initial
@@ -183,14 +198,68 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
                 prevent issues, where rounding inteferes with the optimization.
                 Accessing the current state via ``optimizer["parameter_name"]``
                 will cast back to half precision.
+
+                The single precision value then serves as the *master weight*:
+                :py:func:`step()` evaluates a half precision copy along with
+                the update, which the forward pass reads instead of the
+                master. Gradients of this copy propagate to the master, where
+                they accumulate in single precision.
+
+            grad_block_size (int | None):
+                When set, the optimizer tracks which blocks of
+                ``grad_block_size`` entries of each flat (1D or tensor)
+                parameter receive a gradient via gathers (see
+                :py:func:`drjit.set_grad_blocks()`). :py:func:`step()` then
+                only reads and writes the touched blocks of the parameter and
+                its optimizer state, which saves memory bandwidth when
+                optimizing large tables (e.g., hash grid encodings), of which
+                each iteration only accesses a small part. This assumes that
+                the parameter is exclusively accessed via gathers---gradients
+                arriving through other operations are ignored. Determining the
+                touched blocks requires a device-host synchronization.
+
+                Only the traffic of the parameter update and optimizer state
+                is reduced: the gradient is still accumulated densely, and
+                marking the blocks adds a small scatter to each reverse-mode
+                traversal of a gather. The touched entries are written back
+                in place, which requires that no other references to the
+                parameter remain when :py:func:`step()` is called (e.g., an
+                unevaluated result of a gather from it). Otherwise, the
+                parameter and its state are copied.
+
+            lazy (bool):
+                Set this parameter to ``True`` to only update entries of flat
+                (1D or tensor) parameters that received a nonzero gradient.
+                This implies ``mask_updates=True``, but instead of blending
+                the old and new state of *every* entry, :py:func:`step()`
+                compacts the nonzero entries and only reads and writes those,
+                which is much cheaper when each iteration touches a small part
+                of a large parameter. Compaction requires a device-host
+                synchronization. As with ``grad_block_size``, the entries are
+                only written back in place when no other references to the
+                parameter remain at the time of the step. Optimizers with iteration-dependent state
+                (e.g., :py:class:`Adam`'s bias correction) switch to a
+                per-entry step counter in this mode.
+
+            grad_scaler (GradScaler | None):
+                Route :py:func:`step()` through the given
+                :py:class:`GradScaler`, which unscales gradients and skips
+                steps with overflows. Scale the loss via
+                :py:func:`GradScaler.scale()` before propagating gradients.
+                The overflow check is evaluated in a separate kernel that
+                precedes the update. See :py:func:`GradScaler.step()`.
         """
 
         if isinstance(lr, float) and lr < 0:
             raise RuntimeError("'lr' must be >0")
 
         self.lr = lr
-        self.mask_updates = mask_updates
+        self.mask_updates = mask_updates or lazy
+        self.lazy = lazy
         self.promote_fp16 = promote_fp16
+        self.grad_block_size = grad_block_size
+        self.grad_scaler = grad_scaler
+        self.fp16_cache = {}
         self.state = {}
 
         if params:
@@ -207,7 +276,13 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
 
         # If previously promoted from FP16 -> FP32, cast back
         if entry[1]:
-            value = dr.float16_array_t(value)(value)
+            half = dr.float16_array_t(value)
+            cached = self.fp16_cache.get(key, None)
+            if cached is None:
+                value = half(value)
+            else:
+                # Read the evaluated copy, but differentiate the master
+                value = dr.replace_grad(cached, half(value))
 
         return value
 
@@ -255,6 +330,7 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
             raise RuntimeError(f'Optimizer.__setitem__(): parameter "{key}" is empty!')
 
         prev = self.state.get(key, None)
+        self.fp16_cache.pop(key, None)
 
         # Make a detached copy
         value = dr.detach(value)
@@ -268,6 +344,8 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
         promoted = self.promote_fp16 and dr.type_v(value) == dr.VarType.Float16
         if promoted:
             value = dr.float32_array_t(value)(value)
+        else:
+            self._track_grad_blocks(value)
 
         if prev is not None and prev[0].shape == value.shape:
             self.state[key] = value, promoted, *prev[2:]
@@ -281,6 +359,7 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
     def __delitem__(self, key: str, /) -> None:
         """Remove a parameter from the optimizer."""
         del self.state[key]
+        self.fp16_cache.pop(key, None)
 
     def learning_rate(self, key: Optional[str] = None) -> Optional[LearningRate]:
         """
@@ -436,10 +515,17 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
                 Dr.Jit uses this parameter for automatic mixed-precision training.
         """
 
+        # Optional: unscale gradients and skip steps with overflows
+        if self.grad_scaler is not None and grad_scale is None and active is None:
+            self.grad_scaler.step(self, eval=eval)
+            return
+
         with dr.profile_range('Optimizer.step()'):
             cache = _LRCache()
 
-            for key, (value, promoted, lr, extra) in self.state.items():
+            for key in self.state.keys():
+                value, promoted, lr, extra = self.state[key]
+
                 # Fetch the parameter gradient and convert special array types
                 # (e.g. complex numbers) into ones with element-wise semantics
                 grad = value.grad.array
@@ -449,41 +535,107 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
                 # Use the default or parameter-specific learning rate
                 lr_v = lr if lr is not None else self.lr
 
-                # Optimizer-specific step
+                # Optional: restrict the update to touched gradient blocks
                 value_flat = dr.detach(value).array
+                index = self._touched_index(value, promoted)
+
+                # Optional: further restrict the update to nonzero gradients
+                if self.lazy and dr.depth_v(grad) == 1:
+                    grad_sub = grad if index is None else dr.gather(type(grad), grad, index)
+                    nonzero = dr.compress(grad_sub != 0)
+                    index = nonzero if index is None else dr.gather(type(index), index, nonzero)
+
+                value_tp, shape = type(value), value.shape
+                if index is not None:
+                    value_full, extra_full = value_flat, extra
+                    value_flat = dr.gather(type(value_full), value_full, index)
+                    grad = dr.gather(type(grad), grad, index)
+                    extra = self._gather_extra(extra, index, dr.width(value_full))
+
+                    # Evaluate the subset and release all other references to
+                    # the full-sized state. The scatters below then update it
+                    # in place instead of copying it (see :ref:`Copy-On-Write
+                    # <cow>`). References held elsewhere, e.g. by the caller,
+                    # still cause a copy.
+                    dr.eval(value_flat, grad, extra)
+                    self.state[key] = None, promoted, lr, None  # type: ignore
+                    del value
+
+                # Optimizer-specific step
                 new_value, new_extra = self._step(cache, value_flat, grad, lr_v, extra)
+                new_value, new_extra = self._mask(
+                    grad, active, value_flat, new_value, extra, new_extra
+                )
+
+                # Write the updated blocks back into the full-sized state
+                if index is not None:
+                    new_value = self._scatter_extra(value_full, new_value, index)
+                    new_extra = self._scatter_extra(extra_full, new_extra, index)
+
+                self._commit(key, value_tp, shape, new_value, new_extra)
+
+            # Submit a kernel containing queued parameter updates
+            if eval:
+                dr.eval()
 
-                # Optional: mask updates to components with zero-valued gradients
-                mask = False
-                if self.mask_updates:
-                    mask |= grad == 0
+    # Blend the old and new state following 'mask_updates' and 'active'
+    def _mask(
+        self,
+        grad: dr.ArrayBase,
+        active: Optional[dr.ArrayBase],
+        value: dr.ArrayBase,
+        new_value: dr.ArrayBase,
+        extra: Extra,
+        new_extra: Extra,
+        /,
+    ) -> Tuple[dr.ArrayBase, Extra]:
+        # Optional: mask updates to components with zero-valued gradients
+        mask = False
+        if self.mask_updates:
+            mask |= grad == 0
 
-                # Optional: mask updates, e.g., due to adaptive multi precision training
-                if active is not None:
-                    mask |= ~active
+        # Optional: mask updates, e.g., due to adaptive multi precision training
+        if active is not None:
+            mask |= ~active
 
-                if mask is not False:
-                    new_value = dr.select(mask, value_flat, new_value)
-                    new_extra = self._select(mask, extra, new_extra)
+        if mask is not False:
+            new_value = dr.select(mask, value, new_value)
+            new_extra = self._select(mask, extra, new_extra)
 
-                # Construct new parameter value and reattach to AD graph
-                value_tp = type(value)
-                if type(new_value) is not value_tp:
-                    if dr.is_tensor_v(value_tp):
-                        new_value = value_tp(new_value, value.shape)
-                    else:
-                        new_value = value_tp(new_value)
-                dr.enable_grad(new_value)
+        return new_value, new_extra
 
-                # Update the optimizer state and schedule it for evaluation
-                new_state = new_value, promoted, lr, new_extra
+    # Construct the new parameter value, reattach it to the AD graph, and
+    # schedule the updated optimizer state for evaluation
+    def _commit(
+        self,
+        key: str,
+        value_tp: Type[dr.ArrayBase],
+        shape: Tuple[int, ...],
+        new_value: dr.ArrayBase,
+        new_extra: Extra,
+        /,
+    ) -> None:
+        _, promoted, lr, _ = self.state[key]
+
+        if type(new_value) is not value_tp:
+            if dr.is_tensor_v(value_tp):
+                new_value = value_tp(new_value, shape)
+            else:
+                new_value = value_tp(new_value)
+        dr.enable_grad(new_value)
+        if not promoted:
+            self._track_grad_blocks(new_value)
 
-                dr.schedule(new_state)
-                self.state[key] = new_state
+        new_state = new_value, promoted, lr, new_extra
 
-            # Submit a kernel containing queued parameter updates
-            if eval:
-                dr.eval()
+        dr.schedule(new_state)
+        self.state[key] = new_state
+
+        # Evaluate the half precision copy used by the forward pass
+        if promoted:
+            half = dr.float16_array_t(value_tp)(dr.detach(new_value))
+            dr.schedule(half)
+            self.fp16_cache[key] = half
 
     # To be provided by subclasses
     def _step(
@@ -507,6 +659,59 @@ class Optimizer(Generic[Extra], MutableMapping[str, dr.ArrayBase]):
     def _select(self, mask: dr.ArrayBase, extra: Extra, new_extra: Extra, /) -> Extra:
         return dr.select(mask, extra, new_extra)
 
+    # Enable gradient block tracking for flat parameters, if requested
+    def _track_grad_blocks(self, value: dr.ArrayBase, /) -> None:
+        if self.grad_block_size and \
+           (dr.is_tensor_v(value) or dr.depth_v(value) == 1):
+            dr.set_grad_blocks(value, self.grad_block_size)
+
+    # Return the indices of parameter entries within touched gradient blocks,
+    # or ``None`` when the update should be dense
+    def _touched_index(self, value: dr.ArrayBase, promoted: bool, /) -> Optional[dr.ArrayBase]:
+        if not self.grad_block_size or promoted or \
+           not (dr.is_tensor_v(value) or dr.depth_v(value) == 1):
+            return None
+
+        touched = dr.grad_blocks(value)
+        if touched is None:
+            return None
+
+        size = dr.width(value.array)
+        UInt = dr.uint32_array_t(type(touched))
+        block_size = self.grad_block_size
+
+        blocks = dr.compress(touched)
+        index = dr.repeat(blocks * block_size, block_size) + \
+                dr.tile(dr.arange(UInt, block_size), dr.width(blocks))
+
+        # The last block may extend past the end of the parameter
+        if size % block_size != 0:
+            index = dr.gather(UInt, index, dr.compress(index < size))
+
+        return index
+
+    # Gather the entries of the extra state that are associated with 'index'
+    def _gather_extra(self, extra: Any, index: dr.ArrayBase, size: int, /) -> Any:
+        if isinstance(extra, tuple):
+            return tuple(self._gather_extra(v, index, size) for v in extra)
+        elif dr.is_array_v(extra) and dr.width(extra) == size:
+            return dr.gather(type(extra), extra, index)
+        else:
+            return extra
+
+    # Write a subset produced by _gather_extra() back into the full state.
+    # This modifies 'full', which avoids a copy if nothing else references it.
+    def _scatter_extra(self, full: Any, subset: Any, index: dr.ArrayBase, /) -> Any:
+        if isinstance(full, tuple):
+            return tuple(self._scatter_extra(f, v, index)
+                         for f, v in zip(full, subset))
+        elif dr.is_array_v(full) and dr.width(subset) == dr.width(index) and \
+             dr.width(full) != dr.width(subset):
+            dr.scatter(full, subset, index)
+            return full
+        else:
+            return subset
+
     # Optional: optimizers can override/patch this method to filter
     # ineligible parameters
     def _filter(self, params: Mapping[str, dr.ArrayBase], /) -> Mapping[str, dr.ArrayBase]:
@@ -618,6 +823,9 @@ class SGD(Optimizer[Optional[dr.ArrayBase]]):
         nesterov: bool = False,
         mask_updates: bool = False,
         promote_fp16: bool = True,
+        grad_block_size: Optional[int] = None,
+        lazy: bool = False,
+        grad_scaler: Optional["GradScaler"] = None,
     ):
         """
         Args:
@@ -640,6 +848,18 @@ class SGD(Optimizer[Optional[dr.ArrayBase]]):
                 promoted half-precision variables to single precision internal storage?
                 See :py:func:`Optimizer.__init__()` for details on this parameter.
 
+            grad_block_size (int | None):
+                Only update gradient blocks touched by gathers?
+                See :py:func:`Optimizer.__init__()` for details on this parameter.
+
+            lazy (bool):
+                Only update entries with a nonzero gradient?
+                See :py:func:`Optimizer.__init__()` for details on this parameter.
+
+            grad_scaler (GradScaler | None):
+                Gradient scaler for automatic mixed-precision training.
+                See :py:func:`Optimizer.__init__()` for details on this parameter.
+
             params (Mapping[str, drjit.ArrayBase] | None):
                 Optional dictionary-like object containing an initial set of
                 parameters.
@@ -658,7 +878,10 @@ class SGD(Optimizer[Optional[dr.ArrayBase]]):
             lr,
             params,
             mask_updates=mask_updates,
-            promote_fp16=promote_fp16
+            promote_fp16=promote_fp16,
+            grad_block_size=grad_block_size,
+            lazy=lazy,
+            grad_scaler=grad_scaler
         )
 
     # To be provided by subclasses
@@ -765,6 +988,9 @@ class RMSProp(Optimizer[dr.ArrayBase]):
         epsilon: float = 1e-8,
         mask_updates: bool = False,
         promote_fp16: bool = True,
+        grad_block_size: Optional[int] = None,
+        lazy: bool = False,
+        grad_scaler: Optional["GradScaler"] = None,
     ):
         """
         Construct a RMSProp optimizer instance.
@@ -790,6 +1016,18 @@ class RMSProp(Optimizer[dr.ArrayBase]):
                 promoted half-precision variables to single precision internal storage?
                 See :py:func:`Optimizer.__init__()` for details on this parameter.
 
+            grad_block_size (int | None):
+                Only update gradient blocks touched by gathers?
+                See :py:func:`Optimizer.__init__()` for details on this parameter.
+
+            lazy (bool):
+                Only update entries with a nonzero gradient?
+                See :py:func:`Optimizer.__init__()` for details on this parameter.
+
+            grad_scaler (GradScaler | None):
+                Gradient scaler for automatic mixed-precision training.
+                See :py:func:`Optimizer.__init__()` for details on this parameter.
+
             params (Mapping[str, drjit.ArrayBase] | None):
                 Optional dictionary-like object containing an initial set of
                 parameters.
@@ -799,7 +1037,10 @@ class RMSProp(Optimizer[dr.ArrayBase]):
             lr,
             params,
             mask_updates=mask_updates,
-            promote_fp16=promote_fp16
+            promote_fp16=promote_fp16,
+            grad_block_size=grad_block_size,
+            lazy=lazy,
+            grad_scaler=grad_scaler
         )
 
         if alpha < 0 or alpha >= 1:
@@ -908,6 +1149,11 @@ class Adam(Optimizer[Tuple[int, dr.ArrayBase, dr.ArrayBase]]):
 
     This class also implements two extensions that are turned off by default.
     See the descriptions of the ``mask_updates`` and ``uniform`` parameters below.
+
+    With ``lazy=True``, the iteration count :math:`i` in the above scale factor
+    is tracked *per entry* and only advances when the entry receives a nonzero
+    gradient. This keeps the bias correction exact for sparsely updated
+    parameters, similar to the *LazyAdam* variant found in other frameworks.
     """
 
     # First moment EMA weight
@@ -936,6 +1182,9 @@ class Adam(Optimizer[Tuple[int, dr.ArrayBase, dr.ArrayBase]]):
         mask_updates: bool = False,
         promote_fp16: bool = True,
         uniform: bool = False,
+        grad_block_size: Optional[int] = None,
+        lazy: bool = False,
+        grad_scaler: Optional["GradScaler"] = None,
     ):
         """
         Construct a new Adam optimizer object. The default parameters
@@ -973,6 +1222,18 @@ class Adam(Optimizer[Tuple[int, dr.ArrayBase, dr.ArrayBase]]):
                 promoted half-precision variables to single precision internal storage?
                 See :py:func:`Optimizer.__init__()` for details on this parameter.
 
+            grad_block_size (int | None):
+                Only update gradient blocks touched by gathers?
+                See :py:func:`Optimizer.__init__()` for details on this parameter.
+
+            lazy (bool):
+                Only update entries with a nonzero gradient?
+                See :py:func:`Optimizer.__init__()` for details on this parameter.
+
+            grad_scaler (GradScaler | None):
+                Gradient scaler for automatic mixed-precision training.
+                See :py:func:`Optimizer.__init__()` for details on this parameter.
+
             params (Mapping[str, drjit.ArrayBase] | None):
                 Optional dictionary-like object containing an initial set of
                 parameters.
@@ -982,7 +1243,10 @@ class Adam(Optimizer[Tuple[int, dr.ArrayBase, dr.ArrayBase]]):
             lr,
             params,
             mask_updates=mask_updates,
-            promote_fp16=promote_fp16
+            promote_fp16=promote_fp16,
+            grad_block_size=grad_block_size,
+            lazy=lazy,
+            grad_scaler=grad_scaler
         )
 
         if beta_1 < 0 or beta_1 >= 1:
@@ -1024,16 +1288,24 @@ class Adam(Optimizer[Tuple[int, dr.ArrayBase, dr.ArrayBase]]):
         # - EMA debiasing factor
         # - Adaptive/parameter-specific scaling
         Base = dr.leaf_t(grad)
-        Float64 = dr.float64_array_t(dr.leaf_t(grad))
-        ema_factor = Base(
-            -dr.sqrt(1 - Float64(self.beta_2) ** t) /
-                    (1 - Float64(self.beta_1) ** t)
-        )
-        scale = cache.product(
-            dr.leaf_t(grad),  # Desired type
-            lr,
-            ema_factor,
-        )
+        if self.lazy:
+            # Per-entry iteration count, evaluate the debiasing factor per entry
+            Float = type(grad)
+            t_f = Float(t)
+            ema_factor = -dr.sqrt(1 - dr.power(Float(self.beta_2), t_f)) / \
+                              (1 - dr.power(Float(self.beta_1), t_f))
+            scale = cache.product(Base, lr) * ema_factor
+        else:
+            Float64 = dr.float64_array_t(dr.leaf_t(grad))
+            ema_factor = Base(
+                -dr.sqrt(1 - Float64(self.beta_2) ** t) /
+                        (1 - Float64(self.beta_1) ** t)
+            )
+            scale = cache.product(
+                dr.leaf_t(grad),  # Desired type
+                lr,
+                ema_factor,
+            )
 
         # Optional: use maximum of second order term
         v_tm = dr.max(v_t) if self.uniform else v_t
@@ -1050,8 +1322,11 @@ class Adam(Optimizer[Tuple[int, dr.ArrayBase, dr.ArrayBase]]):
     def _reset(self, key: str, value: dr.ArrayBase, promoted: bool, /) -> None:
         valarr = value.array
         tp = type(valarr)
-        UInt = dr.uint32_array_t(dr.leaf_t(tp))
-        t = UInt(0)
+        if self.lazy:
+            t = dr.opaque(dr.uint32_array_t(tp), 0, valarr.shape)
+        else:
+            UInt = dr.uint32_array_t(dr.leaf_t(tp))
+            t = UInt(0)
         m_t = dr.opaque(tp, 0, valarr.shape)
         v_t = dr.opaque(tp, 0, valarr.shape)
         self.state[key] = value, promoted, None, (t, m_t, v_t)
@@ -1067,8 +1342,9 @@ class Adam(Optimizer[Tuple[int, dr.ArrayBase, dr.ArrayBase]]):
         # Known issue: we don't mask the update to 't' here. That would
         # require moving this parameter to the GPU, with a whole bunch
         # of downsides. It is only relevant for AMP training. Oh well.
+        # In lazy mode, 't' is a per-entry array that can be masked.
         return (
-            new_extra[0],
+            dr.select(mask, extra[0], new_extra[0]) if self.lazy else new_extra[0],
             dr.select(mask, extra[1], new_extra[1]),
             dr.select(mask, extra[2], new_extra[2]),
         )
@@ -1233,6 +1509,14 @@ class GradScaler:
         """
         Take a gradient step via ``opt``, while being careful to remove the
         previously introduced gradient scale factor.
+
+        This involves two kernel launches: the first checks all gradients for
+        infinite and NaN-valued components, and the second unscales the
+        gradients and performs the (possibly skipped) update. The overflow
+        flag and scale factor remain on the device, hence neither kernel
+        synchronizes with the host unless ``debug=True`` was specified.
+        Whether to skip a step is a global decision that depends on every
+        gradient, which is why the check cannot be folded into the update.
         """
         with dr.profile_range('GradScaler.step()'):
             good: Optional[dr.ArrayBase] = None
@@ -130,6 +130,28 @@ extern DRJIT_EXTRA_EXPORT void ad_accum_grad(uint64_t index, uint32_t value);
 /// Clear the gradient of a given variable
 extern DRJIT_EXTRA_EXPORT void ad_clear_grad(uint64_t index);
 
+/**
+ * \brief Track which blocks of a variable's gradient are touched by gathers
+ *
+ * When \c block_size is nonzero, reverse-mode traversal of gathers reading
+ * from the variable \c index additionally marks the touched blocks of \c
+ * block_size entries. Only gathers recorded after this call are tracked.
+ * Passing \c 0 disables tracking. See \ref ad_var_grad_blocks().
+ */
+extern DRJIT_EXTRA_EXPORT void ad_var_set_grad_blocks(uint64_t index,
+                                                      uint32_t block_size);
+
+/**
+ * \brief Return a boolean JIT array marking the touched gradient blocks of
+ * a variable
+ *
+ * Returns a new reference, or \c 0 if tracking was not enabled via \ref
+ * ad_var_set_grad_blocks(). The marks are reset by \ref ad_clear_grad(). If
+ * \c block_size is not \c nullptr, the function also returns the block size.
+ */
+extern DRJIT_EXTRA_EXPORT uint32_t ad_var_grad_blocks(uint64_t index,
+                                                      uint32_t *block_size);
+
 /// Increase the reference count of the given AD variable
 extern DRJIT_EXTRA_EXPORT uint64_t ad_var_inc_ref_impl(uint64_t) JIT_NOEXCEPT;
 
@@ -182,6 +204,20 @@ extern DRJIT_EXTRA_EXPORT void ad_var_gather_packet(size_t n, uint64_t source,
                                                     uint64_t *out,
                                                     JIT_ENUM ReduceMode mode);
 
+/**
+ * \brief Gather and blend several contiguous n-dimensional vectors
+ *
+ * Computes <tt>out[i] = sum_k weights[k] * source[offsets[k] * n + i]</tt>
+ * for <tt>k < count</tt> and records the result as a single node of the AD
+ * graph. This is used by texture lookups to blend the texels of a filter
+ * footprint. The generated code still contains one gather (and, in reverse
+ * mode, one scatter-add) per footprint entry.
+ */
+extern DRJIT_EXTRA_EXPORT void
+ad_var_gather_footprint(size_t n, uint64_t source, size_t count,
+                        const uint32_t *offsets, const uint64_t *weights,
+                        uint32_t mask, uint64_t *out, JIT_ENUM ReduceMode mode);
+
 /// Perform a differentiable scatter operation. See jit_var_scatter for
 /// signature.
 extern DRJIT_EXTRA_EXPORT uint64_t ad_var_scatter(uint64_t target,
@@ -285,7 +321,11 @@ typedef void (*ad_call_cleanup)(void*);
  *
  * \param symbolic
  *     Set this to \c 0 for evaluated mode, \c 1 for symbolic mode, and \c -1
- *     to select the mode automatically.
+ *     to select the mode automatically based on \c JitFlag::SymbolicCalls.
+ *     The value \c 2 selects the mode adaptively by sampling the divergence of
+ *     \c index. The decision is cached per call site (identified by \c
+ *     variant, \c domain, \c name, \c callable_count, and \c site) and
+ *     periodically revisited.
  *
  * \param callable_count
  *     The number of callables. Must be zero if \c domain is provided instead.
@@ -330,6 +370,16 @@ typedef void (*ad_call_cleanup)(void*);
  *     Should the operation insert a \c CustomOp into the AD graph to
  *     track derivatives? This only affects symbolic mode.
  *
+ * \param coherence
+ *     Optional 32-bit unsigned integer key (e.g., a Morton code). When
+ *     nonzero, evaluated mode reorders the calling threads of each instance by
+ *     this key before invoking the callable, which improves memory coherence
+ *     of the per-instance kernels. Ignored by the other modes.
+ *
+ * \param site
+ *     Optional identifier of the set of callables (e.g., a hash). It
+ *     distinguishes call sites that share the same \c name in adaptive mode.
+ *
  * When the function returns \c true, the caller is responsible for calling
  * \c cleanup to destroy the payload. Otherwise, the AD system has taken over
  * ownership and will eventually destroy the payload.
@@ -343,7 +393,8 @@ ad_call(JitBackend backend, const char *variant, const char *domain,
         int symbolic, size_t callable_count, const char *name, bool is_getter,
         uint32_t index, uint32_t mask, const drjit::vector<uint64_t> &args,
         drjit::vector<uint64_t> &rv, void *payload, ad_call_func callback,
-        ad_call_cleanup cleanup, bool ad);
+        ad_call_cleanup cleanup, bool ad, uint32_t coherence = 0,
+        uint64_t site = 0);
 
 // Callbacks used by \ref ad_loop() below. See the interface for details
 typedef void (*ad_loop_read)(void *payload, drjit::vector<uint64_t> &);
@@ -419,6 +470,74 @@ extern DRJIT_EXTRA_EXPORT bool ad_loop(JitBackend backend, int symbolic, int com
                                        ad_loop_cond cond_cb, ad_loop_body body_cb,
                                        ad_loop_delete delete_cb, bool ad);
 
+/// Policies that control when evaluated loops compress their loop state
+enum class ADCompressPolicy : uint32_t {
+    /// Compress the loop state following every iteration (the default)
+    Always = 0,
+
+    /// Compress when the fraction of active entries drops below a threshold
+    Threshold = 1,
+
+    /// Compress every N iterations
+    Interval = 2,
+
+    /**
+     * Compress when the estimated cost of executing inactive entries during
+     * the remaining iterations exceeds the cost of moving the loop state
+     */
+    CostModel = 3
+};
+
+/// Statistics of the most recent execution of an evaluated compressed loop
+struct ADLoopStats {
+    /// Number of executed loop iterations
+    size_t iterations = 0;
+
+    /// Number of times the loop state was compressed
+    size_t compressions = 0;
+
+    /// Estimated number of bytes moved by compression steps
+    size_t bytes_moved = 0;
+
+    /// Fraction of active entries of the loop state, one per iteration
+    drjit::vector<float> active_fraction;
+};
+
+/**
+ * \brief Set the compression policy of evaluated loops with the given name
+ *
+ * The parameter \c param is interpreted based on \c policy. It specifies the
+ * active fraction threshold (\c Threshold, default: 0.5), the number of
+ * iterations between compression steps (\c Interval, default: 4), or the cost
+ * of moving an entry of the loop state relative to the cost of executing the
+ * loop body on it (\c CostModel, default: 1). Passing \c 0 selects the
+ * default. This only affects evaluated loops that compress their state.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_loop_set_compress_policy(const char *name,
+                                                           ADCompressPolicy policy,
+                                                           double param);
+
+/**
+ * \brief Set the number of iterations per kernel launch of evaluated loops
+ * with the given name
+ *
+ * By default, evaluated loops launch one kernel per iteration and write the
+ * loop state back to memory each time. When \c iterations is greater than
+ * one, evaluated loops on the LLVM backend instead trace several masked
+ * iterations into a single kernel. Each worker thread then keeps the loop
+ * state of its lanes in registers until the end of the launch. The loop
+ * condition is only checked between launches. This does not affect loops
+ * with state compression or loops on the CUDA backend.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_loop_set_persistent_iterations(const char *name,
+                                                                 uint32_t iterations);
+
+/// Fetch statistics of the most recent evaluated compressed loop with the given name
+extern DRJIT_EXTRA_EXPORT bool ad_loop_stats(const char *name, ADLoopStats *stats);
+
+/// Clear all loop statistics collected by \ref ad_loop()
+extern DRJIT_EXTRA_EXPORT void ad_loop_stats_clear();
+
 // Callbacks used by \ref ad_cond() below. See the interface for details
 typedef void (*ad_cond_body)(void *payload, bool value,
                              const drjit::vector<uint64_t> &args_i,
@@ -437,7 +556,12 @@ typedef void (*ad_cond_delete)(void *payload);
  *
  * \param symbolic
  *     Set this to \c 0 for evaluated mode, \c 1 for symbolic mode, and \c -1
- *     to select the mode automatically.
+ *     to select the mode automatically. The value \c 2 enables auto mode,
+ *     which evaluates the condition and counts the lanes taking each branch.
+ *     It directly executes the only branch with active lanes if there is
+ *     one, and otherwise selects evaluated mode for large conditionals with a
+ *     strongly unbalanced branch. The counts are recorded per \c name, see
+ *     \ref ad_cond_stats().
  *
  * \param name
  *     A descriptive name used in debug message / GraphViz visualizations
@@ -479,6 +603,33 @@ ad_cond(JitBackend backend, int symbolic, const char *name, void *payload,
         drjit::vector<uint64_t> &rv, ad_cond_body body_cb,
         ad_cond_delete delete_cb, bool ad);
 
+/// Branch statistics of a conditional statement, see \ref ad_cond()
+struct ADCondStats {
+    /// Number of executions of the conditional
+    size_t calls = 0;
+
+    /// Total number of active lanes that took the \c true branch
+    size_t lanes_true = 0;
+
+    /// Total number of active lanes that took the \c false branch
+    size_t lanes_false = 0;
+
+    /// Number of executions in auto mode that skipped a branch without
+    /// active lanes
+    size_t skipped = 0;
+
+    /// Number of executions that selected evaluated mode
+    size_t evaluated = 0;
+};
+
+/// Fetch the branch statistics of conditionals with the given name. Lane counts
+/// of symbolic and evaluated executions are accumulated on the device, and
+/// reading them synchronizes with the device.
+extern DRJIT_EXTRA_EXPORT bool ad_cond_stats(const char *name, ADCondStats *stats);
+
+/// Clear all branch statistics collected by \ref ad_cond()
+extern DRJIT_EXTRA_EXPORT void ad_cond_stats_clear();
+
 /// Inform the AD layer that a state variable is temporarily being rewritten
 /// by a symbolic operation
 extern DRJIT_EXTRA_EXPORT void ad_var_map_put(uint64_t source, uint64_t target);
@@ -493,6 +644,15 @@ extern DRJIT_EXTRA_EXPORT void ad_set_leak_warnings(int value);
 /// Extract the i-th predecessor of an AD node (or return 0)
 extern DRJIT_EXTRA_EXPORT uint32_t ad_pred(uint32_t index, uint32_t i);
 
+/**
+ * \brief Estimate the memory (in bytes) retained by the AD graph
+ *
+ * Sums up the size of the (non-literal) edge weights that are kept alive for
+ * derivative propagation. State captured by custom operations is not
+ * included. The function visits every edge of the graph.
+ */
+extern DRJIT_EXTRA_EXPORT size_t ad_graph_bytes();
+
 #if defined(__GNUC__)
 DRJIT_INLINE uint64_t ad_var_inc_ref(uint64_t index) JIT_NOEXCEPT {
     /* If 'index' is known at compile time, it can only be zero, in
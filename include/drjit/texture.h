@@ -38,6 +38,18 @@ enum class WrapMode : uint32_t {
     Mirror = 2  /// Mirrors the texture wrt. each edge
 };
 
+/// Texel storage layouts
+enum class TextureLayout : uint32_t {
+    Linear = 0, /// Row-major storage
+    Tiled = 1   /// Row-major storage of small row-major tiles (LLVM only)
+};
+
+/// Texel storage formats
+enum class TextureFormat : uint32_t {
+    Full = 0,      /// Texels are stored using the texture's storage type
+    Quantized8 = 1 /// 8-bit texels with a scale/offset per block (read-only)
+};
+
 /// Texture data type
 enum class CudaTextureFormat : uint32_t {
     Float32 = 0, /// Single precision storage format
@@ -53,6 +65,8 @@ public:
     static constexpr bool IsHalf = std::is_same_v<scalar_t<Storage_>, drjit::half>;
     static constexpr bool IsSingle = std::is_same_v<scalar_t<Storage_>, float>;
     static constexpr bool HasCudaTexture = (IsHalf || IsSingle) && IsCUDA;
+    static constexpr bool SupportsTiling =
+        is_jit_v<Storage_> && !IsCUDA && Dimension > 1;
     static constexpr int CudaFormat = HasCudaTexture ?
         IsHalf ? (int)CudaTextureFormat::Float16 : (int)CudaTextureFormat::Float32 : -1;
 
@@ -63,6 +77,15 @@ public:
         DynamicArray<Storage_>, Storage_*>;
     using TensorXf = Tensor<Storage>;
 
+    /// Side length of a tile in the \ref TextureLayout::Tiled layout
+    static constexpr uint32_t TileSize = 4;
+    static constexpr uint32_t TileShift = 2;
+    static constexpr uint32_t TileTexels = Dimension == 3 ? 64 : 16;
+
+    /// Number of consecutive texels sharing a scale/offset when quantized
+    static constexpr uint32_t QuantBlock = 64;
+    static constexpr uint32_t QuantShift = 6;
+
     #define DR_TEX_ALLOC_PACKET(name, size)                     \
         Packet _packet;                                         \
         Storage_* name;                                         \
@@ -157,6 +180,18 @@ public:
         m_use_accel = other.m_use_accel;
         m_migrated = other.m_migrated;
         m_tensor_dirty = other.m_tensor_dirty;
+        m_mip_value = std::move(other.m_mip_value);
+        m_mip_offset = std::move(other.m_mip_offset);
+        m_mip_levels = other.m_mip_levels;
+        m_mip_dirty = other.m_mip_dirty;
+        m_layout = other.m_layout;
+        for (size_t i = 0; i < Dimension; ++i)
+            m_tiles[i] = other.m_tiles[i];
+        m_tiles_opaque = std::move(other.m_tiles_opaque);
+        m_format = other.m_format;
+        m_quant_value = std::move(other.m_quant_value);
+        m_quant_scale = std::move(other.m_quant_scale);
+        m_quant_offset = std::move(other.m_quant_offset);
     }
 
     Texture &operator=(Texture &&other) noexcept {
@@ -179,6 +214,18 @@ public:
         m_use_accel = other.m_use_accel;
         m_migrated = other.m_migrated;
         m_tensor_dirty = other.m_tensor_dirty;
+        m_mip_value = std::move(other.m_mip_value);
+        m_mip_offset = std::move(other.m_mip_offset);
+        m_mip_levels = other.m_mip_levels;
+        m_mip_dirty = other.m_mip_dirty;
+        m_layout = other.m_layout;
+        for (size_t i = 0; i < Dimension; ++i)
+            m_tiles[i] = other.m_tiles[i];
+        m_tiles_opaque = std::move(other.m_tiles_opaque);
+        m_format = other.m_format;
+        m_quant_value = std::move(other.m_quant_value);
+        m_quant_scale = std::move(other.m_quant_scale);
+        m_quant_offset = std::move(other.m_quant_offset);
         return *this;
     }
 
@@ -206,6 +253,108 @@ public:
     bool migrated() const { return m_migrated; }
     bool use_accel() const { return m_use_accel; }
 
+    /// Return the texel storage layout
+    TextureLayout layout() const { return m_layout; }
+
+    /**
+     * \brief Change the texel storage layout
+     *
+     * With \ref TextureLayout::Tiled, texels are stored in tiles of \ref
+     * TileSize texels along each axis, so that the neighborhood referenced by
+     * a linear or cubic lookup typically lies within one or two cache lines.
+     * This benefits spatially coherent lookups with \ref eval_nonaccel() on
+     * the LLVM backend. The layout is transparent: \ref set_value(), \ref
+     * set_tensor(), and \ref tensor() continue to use row-major data. The
+     * setting has no effect on 1D textures and on other backends.
+     */
+    void set_layout(TextureLayout layout) {
+        if (layout == m_layout)
+            return;
+
+        if constexpr (SupportsTiling) {
+            Storage value = tensor().array();
+            m_layout = layout;
+            set_value(value);
+        } else {
+            m_layout = layout;
+        }
+    }
+
+    /// Return the texel storage format
+    TextureFormat format() const { return m_format; }
+
+    /**
+     * \brief Change the texel storage format
+     *
+     * With \ref TextureFormat::Quantized8, every channel of a block of \ref
+     * QuantBlock consecutively stored texels is encoded with 8 bits relative
+     * to the block's minimum and range. The full-precision texels are
+     * released, and lookups decode the texels they access on the fly. Such
+     * textures are meant for inference: lookups are not differentiable with
+     * respect to the texture values, and attempting to quantize values that
+     * are attached to the AD graph raises an exception. \ref set_value() and
+     * \ref set_tensor() re-encode the provided data, and \ref tensor()
+     * returns the decoded texels. Compressed formats require a JIT backend
+     * and cannot be combined with hardware-accelerated CUDA textures.
+     */
+    void set_format(TextureFormat format) {
+        if (format == m_format)
+            return;
+
+        if constexpr (!is_jit_v<Storage_>) {
+            jit_raise("Texture::set_format(): compressed formats require a "
+                      "JIT backend!");
+        } else {
+            if (format != TextureFormat::Full && HasCudaTexture && m_use_accel)
+                jit_raise("Texture::set_format(): compressed formats require "
+                          "use_accel=False!");
+
+            Storage value = tensor().array();
+            if constexpr (IsDiff) {
+                if (format != TextureFormat::Full && grad_enabled(value))
+                    jit_raise("Texture::set_format(): quantized textures are "
+                              "not differentiable, detach the texture values "
+                              "before changing the format!");
+            }
+
+            m_format = format;
+            set_value(detach(value));
+        }
+    }
+
+    /// Return the number of MIP levels (1 if no MIP map was requested)
+    size_t mipmap_levels() const { return m_mip_levels; }
+
+    /**
+     * \brief Enable a MIP map pyramid with the given number of levels
+     *
+     * Each level halves the resolution of its predecessor along every axis
+     * (down to a single texel), averaging groups of up to 2^Dimension texels.
+     * A value of \c 0 requests the full pyramid, and \c 1 disables MIP
+     * mapping. The pyramid is built immediately by this function and
+     * rebuilt by every subsequent \ref set_value() or \ref set_tensor(). It
+     * is computed with differentiable gathers, hence derivatives of filtered
+     * lookups propagate to the texture values. The pyramid stores a
+     * row-major copy of level 0 as well, which roughly doubles the memory
+     * footprint of a 2D texture.
+     *
+     * MIP mapping is not supported for textures that were migrated to GPU
+     * texture memory.
+     */
+    void build_mipmaps(size_t levels = 0) {
+        if (m_migrated && levels != 1)
+            jit_raise("Texture::build_mipmaps(): MIP mapping is not supported "
+                      "for migrated textures!");
+
+        size_t max_levels = max_mip_levels();
+        m_mip_levels = levels == 0 ? max_levels : std::min(levels, max_levels);
+        m_mip_dirty = true;
+        m_mip_value = Storage();
+
+        if (m_mip_levels > 1)
+            update_mipmaps();
+    }
+
     /**
      * \brief Override the texture contents with the provided linearized 1D array
      *
@@ -214,11 +363,24 @@ public:
      */
     template <typename StorageT>
     void set_value(StorageT &&value, bool migrate = false) {
+        m_mip_dirty = true;
+
         if constexpr (!is_jit_v<Storage_>) {
             if (value.size() != m_size)
                 jit_raise("Texture::set_value(): unexpected array size!");
             m_value.array() = std::forward<StorageT>(value);
         } else /* JIT variant */ {
+            if (migrate && m_mip_levels > 1)
+                jit_raise("Texture::set_value(): MIP mapping is not supported "
+                          "for migrated textures!");
+
+            if constexpr (IsDiff) {
+                if (quantized() && grad_enabled(value))
+                    jit_raise("Texture::set_value(): quantized textures are not "
+                              "differentiable, detach the texture values or "
+                              "switch to TextureFormat::Full first!");
+            }
+
             Storage padded_value;
 
             if (m_channels_storage != m_channels) {
@@ -278,9 +440,42 @@ public:
                 }
             }
 
-            m_value.array() = padded_value;
+            if (tiled()) {
+                // Scatter the row-major texels into their tiles
+                uint32_t channels = (uint32_t) m_channels_storage;
+                UInt32 idx = arange<UInt32>(m_size),
+                       texel = idx / channels,
+                       ch = idx - texel * channels;
+                idx = fmadd(tiled_index(texel), channels, ch);
+
+                size_t tiled_shape[Dimension + 1], tiled_size = channels;
+                for (size_t i = 0; i < Dimension; ++i) {
+                    tiled_shape[i] = m_tiles[Dimension - 1 - i] * TileSize;
+                    tiled_size *= tiled_shape[i];
+                }
+                tiled_shape[Dimension] = channels;
+
+                Storage tiled_value = zeros<Storage>(tiled_size);
+                scatter(tiled_value, padded_value, idx);
+                m_value = TensorXf(tiled_value, Dimension + 1, tiled_shape);
+            } else if (m_value.array().size() != m_size) {
+                // Switching back from the tiled layout
+                size_t tensor_shape[Dimension + 1];
+                for (size_t i = 0; i < Dimension; ++i)
+                    tensor_shape[i] = m_shape[i];
+                tensor_shape[Dimension] = m_channels_storage;
+                m_value = TensorXf(padded_value, Dimension + 1, tensor_shape);
+            } else {
+                m_value.array() = padded_value;
+            }
             m_tensor_dirty = true;
+
+            if (quantized())
+                quantize();
         }
+
+        if (m_mip_levels > 1)
+            update_mipmaps();
     }
 
     /**
@@ -394,14 +589,17 @@ public:
                 // AD-enabled if the original data `m_value` is also AD-enabled.
                 resume_grad<Storage> ad_scope_guard;
 
-                if (m_channels != m_channels_storage) {
+                Storage texels = this->texels();
+                if (m_channels != m_channels_storage || tiled()) {
                     UInt32 idx = arange<UInt32>(
                         (m_size * m_channels) / m_channels_storage
                     );
                     UInt32 pixels_idx = idx / m_channels;
                     UInt32 channel_idx = idx % m_channels;
+                    if (tiled())
+                        pixels_idx = tiled_index(pixels_idx);
                     idx = fmadd(pixels_idx, m_channels_storage, channel_idx);
-                    Storage values = gather<Storage>(m_value.array(), idx);
+                    Storage values = gather<Storage>(texels, idx);
 
                     // On the last call to `set_value` we saved the AD index
                     // of the unpadded values. We can re-attach it here.
@@ -411,7 +609,7 @@ public:
                     else
                         m_unpadded_value.array() = values;
                 } else {
-                    m_unpadded_value.array() = m_value.array();
+                    m_unpadded_value.array() = texels;
                 }
 
                 m_tensor_dirty = false;
@@ -497,7 +695,7 @@ public:
 
             UInt32 idx = index(pos_i_w);
             DR_TEX_ALLOC_PACKET(packet, m_channels_storage);
-            gather_packet_dynamic(m_channels_storage, m_value.array(), idx, packet, active);
+            gather_texels(idx, packet, active);
             for (uint32_t ch = 0; ch < m_channels; ++ch)
                 out[ch] = Value(packet[ch]);
         } else {
@@ -517,18 +715,15 @@ public:
             for (uint32_t ch = 0; ch < m_channels; ++ch)
                 out[ch] = zeros<Value>();
 
+            // Collect the corners of the footprint and blend them in one AD node
+            UInt32 corner_idx[ipow(2, Dimension)];
+            Value corner_weight[ipow(2, Dimension)];
+            size_t corners = 0;
+
             #define DR_TEX_ACCUM(index, weight)                                \
                 {                                                              \
-                    UInt32 index_ = index;                                     \
-                    Value weight_ = weight;                                    \
-                    DR_TEX_ALLOC_PACKET(packet, m_channels_storage);           \
-                    gather_packet_dynamic(m_channels_storage, m_value.array(), \
-                        index_, packet, active);                               \
-                    for (uint32_t ch = 0; ch < m_channels; ++ch)               \
-                        out[ch] = fmadd(                                       \
-                            Value(packet[ch]),                                 \
-                            weight_,                                           \
-                            out[ch]);                                          \
+                    corner_idx[corners] = index;                               \
+                    corner_weight[corners++] = weight;                         \
                 }
 
             const PosF w1 = pos_f - pos_i, w0 = 1.f - w1;
@@ -553,6 +748,8 @@ public:
             }
 
             #undef DR_TEX_ACCUM
+
+            accum_footprint(corners, corner_idx, corner_weight, out, active);
         }
     }
 
@@ -722,8 +919,7 @@ public:
 
         for (size_t i = 0; i < InterpOffset::Size; ++i) {
             DR_TEX_ALLOC_PACKET(packet, m_channels_storage);
-            gather_packet_dynamic(
-                m_channels_storage, m_value.array(), idx[i], packet, active);
+            gather_texels(idx[i], packet, active);
             for (uint32_t ch = 0; ch < m_channels; ++ch)
                 out[i][ch] = Value(packet[ch]);
         }
@@ -833,18 +1029,15 @@ public:
         for (uint32_t ch = 0; ch < m_channels; ++ch)
             out[ch] = zeros<Value>();
 
+        // Collect the corners of the footprint and blend them in one AD node
+        UInt32 corner_idx[ipow(4, Dimension)];
+        Value corner_weight[ipow(4, Dimension)];
+        size_t corners = 0;
+
         #define DR_TEX_CUBIC_ACCUM(index, weight)                              \
             {                                                                  \
-                UInt32 index_ = index;                                         \
-                Value weight_ = weight;                                        \
-                DR_TEX_ALLOC_PACKET(packet, m_channels_storage);               \
-                gather_packet_dynamic(m_channels_storage, m_value.array(),     \
-                    index_, packet, active);                                   \
-                for (uint32_t ch = 0; ch < m_channels; ++ch)                   \
-                    out[ch] = fmadd(                                           \
-                        Value(packet[ch]),                                     \
-                        weight_,                                               \
-                        out[ch]);                                              \
+                corner_idx[corners] = index;                                   \
+                corner_weight[corners++] = weight;                             \
             }
 
         if constexpr (Dimension == 1) {
@@ -869,6 +1062,8 @@ public:
         }
 
         #undef DR_TEX_CUBIC_ACCUM
+
+        accum_footprint(corners, corner_idx, corner_weight, out, active);
     }
 
     /**
@@ -1092,8 +1287,7 @@ public:
             {                                                                  \
                 UInt32 index_ = index;                                         \
                 DR_TEX_ALLOC_PACKET(packet, m_channels_storage);               \
-                gather_packet_dynamic(m_channels_storage, m_value.array(),     \
-                    index_, packet, active);                                   \
+                gather_texels(index_, packet, active);                         \
                 for (uint32_t ch = 0; ch < m_channels; ++ch)                   \
                     values[ch] = Value(packet[ch]);                            \
             }
@@ -1246,8 +1440,7 @@ public:
             {                                                                  \
                 UInt32 index_ = index;                                         \
                 DR_TEX_ALLOC_PACKET(packet, m_channels_storage);               \
-                gather_packet_dynamic(m_channels_storage, m_value.array(),     \
-                    index_, packet, active);                                   \
+                gather_texels(index_, packet, active);                         \
                 for (uint32_t ch = 0; ch < m_channels; ++ch)                   \
                     values[ch] = Value(packet[ch]);                            \
             }
@@ -1359,6 +1552,161 @@ public:
             }
     }
 
+    /**
+     * \brief Evaluate the interpolant of a single MIP level
+     *
+     * Each lane may reference a different \c level. This is an implementation
+     * detail, please use \ref eval_lod() or \ref eval_footprint().
+     */
+    template <typename Value>
+    void eval_level(const Array<Value, Dimension> &pos,
+                    const uint32_array_t<Value> &level, Value *out,
+                    mask_t<Value> active = true) const {
+        using PosF = Array<Value, Dimension>;
+        using PosI = int32_array_t<PosF>;
+        using IntV = int32_array_t<Value>;
+        using UIntV = uint32_array_t<Value>;
+
+        // Per-lane resolution of the referenced level
+        PosI res;
+        for (size_t i = 0; i < Dimension; ++i)
+            res[i] = IntV(maximum(UIntV(m_resolution_opaque[i]) >> level, 1u));
+
+        // Texel offset of the level within the pyramid buffer
+        UIntV offset = gather<UIntV>(m_mip_offset, level, active);
+
+        for (uint32_t ch = 0; ch < m_channels; ++ch)
+            out[ch] = zeros<Value>();
+
+        auto accum = [&](const PosI &p, const Value &weight) {
+            PosI p_w = wrap_level(p, res);
+
+            UIntV idx;
+            if constexpr (Dimension == 1)
+                idx = UIntV(p_w.x());
+            else if constexpr (Dimension == 2)
+                idx = fmadd(UIntV(p_w.y()), UIntV(res.x()), UIntV(p_w.x()));
+            else if constexpr (Dimension == 3)
+                idx = fmadd(fmadd(UIntV(p_w.z()), UIntV(res.y()), UIntV(p_w.y())),
+                            UIntV(res.x()), UIntV(p_w.x()));
+
+            DR_TEX_ALLOC_PACKET(packet, m_channels_storage);
+            gather_packet_dynamic(m_channels_storage, m_mip_value,
+                                  idx + offset, packet, active);
+            for (uint32_t ch = 0; ch < m_channels; ++ch)
+                out[ch] = fmadd(Value(packet[ch]), weight, out[ch]);
+        };
+
+        const PosF res_f = PosF(res);
+
+        if (DRJIT_UNLIKELY(m_filter_mode == FilterMode::Nearest)) {
+            accum(floor2int<PosI>(pos * res_f), Value(1.f));
+        } else {
+            const PosF pos_f = fmadd(pos, res_f, -.5f);
+            const PosI pos_i = floor2int<PosI>(pos_f);
+            const PosF w1 = pos_f - PosF(pos_i), w0 = 1.f - w1;
+
+            for (uint32_t corner = 0; corner < (1u << Dimension); ++corner) {
+                PosI p = pos_i;
+                Value weight = 1.f;
+                for (size_t i = 0; i < Dimension; ++i) {
+                    bool upper = (corner >> i) & 1;
+                    if (upper)
+                        p[i] += 1;
+                    weight *= upper ? w1[i] : w0[i];
+                }
+                accum(p, weight);
+            }
+        }
+    }
+
+    /**
+     * \brief Evaluate the MIP mapped texture at the given level of detail
+     *
+     * The level of detail \c lod is clamped to the range of available levels
+     * (see \ref build_mipmaps()). Fractional values blend the two adjacent
+     * levels, which amounts to trilinear filtering in the 2D case. Without a
+     * MIP map, this function is equivalent to \ref eval_nonaccel().
+     */
+    template <typename Value>
+    void eval_lod(const Array<Value, Dimension> &pos, const Value &lod,
+                  Value *out, mask_t<Value> active = true) const {
+        using UIntV = uint32_array_t<Value>;
+        using IntV = int32_array_t<Value>;
+        using ArrayX = DynamicArray<Value>;
+
+        if (m_mip_levels <= 1) {
+            eval_nonaccel(pos, out, active);
+            return;
+        }
+
+        update_mipmaps();
+
+        Value lod_c = clip(lod, 0.f, (float) (m_mip_levels - 1));
+        UIntV l0 = UIntV(floor2int<IntV>(lod_c)),
+              l1 = minimum(l0 + 1u, (uint32_t) (m_mip_levels - 1));
+        Value t = lod_c - Value(l0);
+
+        ArrayX out_1 = empty<ArrayX>(m_channels);
+        eval_level(pos, l0, out, active);
+        eval_level(pos, l1, out_1.data(), active && t > 0.f);
+
+        for (uint32_t ch = 0; ch < m_channels; ++ch)
+            out[ch] = select(t > 0.f, lerp(out[ch], out_1[ch], t), out[ch]);
+    }
+
+    /**
+     * \brief Evaluate the MIP mapped texture given the screen-space
+     * derivatives of the lookup position
+     *
+     * The derivatives \c dp_dx and \c dp_dy span the footprint of the
+     * lookup. With \c max_anisotropy <= 1, the level of detail follows the
+     * longer footprint axis (isotropic trilinear filtering). Otherwise, up to
+     * \c max_anisotropy lookups are placed along the longer axis at a level
+     * of detail matching the shorter axis (anisotropic filtering), which
+     * preserves detail on surfaces viewed at grazing angles.
+     */
+    template <typename Value>
+    void eval_footprint(const Array<Value, Dimension> &pos,
+                        const Array<Value, Dimension> &dp_dx,
+                        const Array<Value, Dimension> &dp_dy, Value *out,
+                        mask_t<Value> active = true,
+                        uint32_t max_anisotropy = 1) const {
+        using PosF = Array<Value, Dimension>;
+        using ArrayX = DynamicArray<Value>;
+
+        const PosF res_f = PosF(m_resolution_opaque);
+        Value len_x = norm(dp_dx * res_f),
+              len_y = norm(dp_dy * res_f),
+              major = maximum(len_x, len_y),
+              minor = minimum(len_x, len_y);
+
+        if (max_anisotropy <= 1) {
+            eval_lod(pos, log2(maximum(major, 1e-8f)), out, active);
+            return;
+        }
+
+        Value count = clip(ceil(major / maximum(minor, 1e-8f)), 1.f,
+                           (float) max_anisotropy),
+              lod = log2(maximum(major / count, 1e-8f));
+        PosF axis = select(len_x > len_y, dp_dx, dp_dy);
+
+        ArrayX tmp = empty<ArrayX>(m_channels);
+        for (uint32_t ch = 0; ch < m_channels; ++ch)
+            out[ch] = zeros<Value>();
+
+        for (uint32_t i = 0; i < max_anisotropy; ++i) {
+            mask_t<Value> active_i = active && (float) i < count;
+            Value offset = ((float) i + .5f) / count - .5f;
+            eval_lod(fmadd(axis, offset, pos), lod, tmp.data(), active_i);
+            for (uint32_t ch = 0; ch < m_channels; ++ch)
+                out[ch] += select(active_i, tmp[ch], 0.f);
+        }
+
+        for (uint32_t ch = 0; ch < m_channels; ++ch)
+            out[ch] /= count;
+    }
+
     /**
      * \brief Applies the configured texture wrapping mode to an integer
      * position
@@ -1394,6 +1742,26 @@ public:
         }
     }
 
+    /**
+     * \brief Applies the configured texture wrapping mode to an integer
+     * position within a MIP level of (per-lane) resolution \c res
+     */
+    template <typename T> T wrap_level(const T &pos, const T &res) const {
+        if (m_wrap_mode == WrapMode::Clamp) {
+            return clip(pos, 0, res - 1);
+        } else {
+            T value_shift_neg = select(pos < 0, pos + 1, pos);
+            T div = value_shift_neg / res;
+            T mod = pos - div * res;
+            mod[mod < 0] += res;
+
+            if (m_wrap_mode == WrapMode::Mirror)
+                mod = select(((div & 1) == 0) ^ (pos < 0), mod, res - 1 - mod);
+
+            return mod;
+        }
+    }
+
 protected:
     void init(const size_t *shape, size_t channels, bool use_accel,
               FilterMode filter_mode, WrapMode wrap_mode,
@@ -1426,6 +1794,11 @@ protected:
         tensor_shape[Dimension] = m_channels_storage;
         m_shape[Dimension] = channels;
 
+        for (size_t i = 0; i < Dimension; ++i) {
+            m_tiles[i] = (shape[Dimension - 1 - i] + TileSize - 1) / TileSize;
+            m_tiles_opaque[i] = opaque<UInt32>((uint32_t) m_tiles[i]);
+        }
+
         m_use_accel = use_accel;
         m_filter_mode = filter_mode;
         m_wrap_mode = wrap_mode;
@@ -1458,11 +1831,182 @@ protected:
                     (int) filter_mode, (int) wrap_mode);
             }
         }
+
+        // The number of MIP levels may be limited by the new shape. The
+        // pyramid itself is rebuilt by the subsequent set_value() call.
+        m_mip_levels = std::min(m_mip_levels, max_mip_levels());
+        m_mip_dirty = true;
+        m_mip_value = Storage();
+    }
+
+    /**
+     * \brief Accumulate the weighted texels of a filter footprint into `out`
+     *
+     * When the lookup precision matches the storage, the corners are blended
+     * by a footprint gather that is recorded as one AD node (the generated
+     * code still gathers each corner separately). Otherwise, every corner is
+     * gathered and blended by separate operations.
+     */
+    template <typename Value>
+    void accum_footprint(size_t count, const UInt32 *idx, const Value *weight,
+                         Value *out, const mask_t<Value> &active) const {
+        if constexpr (is_jit_v<Value> && std::is_same_v<Value, Storage_>) {
+            if (!quantized()) {
+                Packet packet = zeros<Packet>(m_channels_storage);
+                gather_footprint_dynamic(m_channels_storage, m_value.array(),
+                                         count, idx, weight, packet.data(),
+                                         active);
+                for (uint32_t ch = 0; ch < m_channels; ++ch)
+                    out[ch] += packet[ch];
+                return;
+            }
+        }
+
+        for (size_t k = 0; k < count; ++k) {
+            DR_TEX_ALLOC_PACKET(packet, m_channels_storage);
+            gather_texels(idx[k], packet, active);
+            for (uint32_t ch = 0; ch < m_channels; ++ch)
+                out[ch] = fmadd(Value(packet[ch]), weight[k], out[ch]);
+        }
+    }
+
+    /// Gather the (decoded) channels of the texels at the given storage index
+    template <typename Index, typename Mask>
+    void gather_texels(const Index &idx, Storage_ *out,
+                       const Mask &active) const {
+        if constexpr (is_jit_v<Storage_>) {
+            if (quantized()) {
+                using UInt8 = uint8_array_t<Storage_>;
+                using UInt8X = DynamicArray<UInt8>;
+
+                UInt8X q = empty<UInt8X>(m_channels_storage);
+                Packet scale = empty<Packet>(m_channels_storage),
+                       offset = empty<Packet>(m_channels_storage);
+                Index block = idx >> QuantShift;
+                gather_packet_dynamic(m_channels_storage, m_quant_value, idx,
+                                      q.data(), active);
+                gather_packet_dynamic(m_channels_storage, m_quant_scale, block,
+                                      scale.data(), active);
+                gather_packet_dynamic(m_channels_storage, m_quant_offset, block,
+                                      offset.data(), active);
+                for (size_t ch = 0; ch < m_channels_storage; ++ch)
+                    out[ch] = fmadd(Storage_(q[ch]), scale[ch], offset[ch]);
+                return;
+            }
+        }
+
+        gather_packet_dynamic(m_channels_storage, m_value.array(), idx, out,
+                              active);
     }
 
     #undef DR_TEX_ALLOC_PACKET
 
 private:
+    /// Number of MIP levels of the full pyramid for the current shape
+    size_t max_mip_levels() const {
+        size_t max_res = 1;
+        for (size_t i = 0; i < Dimension; ++i)
+            max_res = std::max(max_res, m_shape[i]);
+
+        size_t max_levels = 1;
+        while ((max_res >> max_levels) > 0)
+            max_levels++;
+        return max_levels;
+    }
+
+    /// (Re-)builds the MIP map pyramid following a change of the texture
+    void update_mipmaps() const {
+        if (!m_mip_dirty)
+            return;
+
+        // Building the pyramid here would bake its computation into the
+        // symbolic region (and rebuild it on every replay)
+        if constexpr (is_jit_v<Storage_>) {
+            if (jit_flag(JitFlag::Recording))
+                jit_raise("Texture: the MIP map pyramid cannot be built within "
+                          "a symbolic region. Call build_mipmaps() or "
+                          "set_value() outside of it.");
+        }
+
+        using UInt32X = uint32_array_t<Storage>;
+        sync_device_data();
+
+        // Resolution of the current level (width, height, depth)
+        uint32_t res[Dimension];
+        for (size_t i = 0; i < Dimension; ++i)
+            res[i] = (uint32_t) m_shape[Dimension - 1 - i];
+
+        uint32_t channels = (uint32_t) m_channels_storage;
+        std::vector<Storage> levels;
+        std::vector<uint32_t> offsets;
+        Storage prev = texels();
+        if constexpr (SupportsTiling) {
+            if (tiled()) {
+                UInt32X idx = arange<UInt32X>((uint32_t) m_size),
+                        texel = idx / channels;
+                idx = fmadd(tiled_index(texel), channels, idx - texel * channels);
+                prev = gather<Storage>(prev, idx);
+            }
+        }
+
+        // Level 0 is part of the pyramid (in row-major order), so that
+        // lookups read each texel from a single buffer regardless of the level
+        uint32_t offset = (uint32_t) (m_size / channels);
+        offsets.push_back(0);
+        levels.push_back(prev);
+
+        for (size_t l = 1; l < m_mip_levels; ++l) {
+            uint32_t res_n[Dimension], count = 1;
+            for (size_t i = 0; i < Dimension; ++i) {
+                res_n[i] = std::max(res[i] / 2u, 1u);
+                count *= res_n[i];
+            }
+
+            UInt32X idx = arange<UInt32X>(count * channels),
+                    texel = idx / channels,
+                    ch = idx - texel * channels,
+                    coord[Dimension];
+
+            for (size_t i = 0; i < Dimension; ++i) {
+                UInt32X next = texel / res_n[i];
+                coord[i] = texel - next * res_n[i];
+                texel = next;
+            }
+
+            // Box filter over (up to) 2^Dimension texels of the previous level
+            Storage value = zeros<Storage>(count * channels);
+            for (uint32_t corner = 0; corner < (1u << Dimension); ++corner) {
+                UInt32X src = 0;
+                for (size_t j = 0; j < Dimension; ++j) {
+                    size_t i = Dimension - 1 - j;
+                    UInt32X c = minimum(coord[i] * 2u + ((corner >> i) & 1u),
+                                        res[i] - 1u);
+                    src = fmadd(src, res[i], c);
+                }
+                value += gather<Storage>(prev, fmadd(src, channels, ch));
+            }
+            value *= 1.f / (float) (1u << Dimension);
+
+            offsets.push_back(offset);
+            offset += count;
+            levels.push_back(value);
+            prev = value;
+            for (size_t i = 0; i < Dimension; ++i)
+                res[i] = res_n[i];
+        }
+
+        // Concatenate the levels into a single buffer
+        Storage mip_value = zeros<Storage>(offset * channels);
+        for (size_t l = 0; l < levels.size(); ++l)
+            scatter(mip_value, levels[l],
+                    arange<UInt32X>((uint32_t) levels[l].size()) +
+                        offsets[l] * channels);
+
+        m_mip_value = mip_value;
+        m_mip_offset = load<UInt32X>(offsets.data(), offsets.size());
+        m_mip_dirty = false;
+    }
+
     /// Updates the device-side padded tensor
     void sync_device_data() const {
         if constexpr (HasCudaTexture) {
@@ -1549,6 +2093,94 @@ private:
         return pos_i;
     }
 
+    /// Does the texture currently use a compressed storage format?
+    bool quantized() const {
+        if constexpr (is_jit_v<Storage_>)
+            return m_format == TextureFormat::Quantized8;
+        else
+            return false;
+    }
+
+    /// Return the padded texels in storage order, decoding compressed formats
+    Storage texels() const {
+        if constexpr (is_jit_v<Storage_>) {
+            if (quantized()) {
+                uint32_t channels = (uint32_t) m_channels_storage;
+                UInt32 idx = arange<UInt32>((uint32_t) m_quant_value.size()),
+                       texel = idx / channels,
+                       block = fmadd(texel >> QuantShift, channels,
+                                     idx - texel * channels);
+                return fmadd(Storage(m_quant_value),
+                             gather<Storage>(m_quant_scale, block),
+                             gather<Storage>(m_quant_offset, block));
+            }
+        }
+        return m_value.array();
+    }
+
+    /**
+     * \brief Encode the texels of \ref m_value using the quantized format
+     *
+     * The channels of every block of \ref QuantBlock consecutive texels are
+     * mapped linearly from [min, max] to [0, 255]. The full-precision texels
+     * are released afterwards.
+     */
+    void quantize() {
+        if constexpr (is_jit_v<Storage_>) {
+            using Float32 = float32_array_t<Storage>;
+
+            uint32_t channels = (uint32_t) m_channels_storage,
+                     texels = (uint32_t) (m_value.array().size() / channels),
+                     blocks = (texels + QuantBlock - 1) / QuantBlock;
+            Float32 value = Float32(detach(m_value.array()));
+
+            // Arrange each channel of a block contiguously, replicating the
+            // last texel to fill the final block
+            UInt32 idx = arange<UInt32>(blocks * channels * QuantBlock),
+                   group = idx >> QuantShift,
+                   block = group / channels,
+                   ch = group - block * channels,
+                   texel = minimum(fmadd(block, QuantBlock, idx & (QuantBlock - 1)),
+                                   texels - 1);
+            Float32 grouped = gather<Float32>(value, fmadd(texel, channels, ch)),
+                    lo = block_reduce(ReduceOp::Min, grouped, QuantBlock),
+                    hi = block_reduce(ReduceOp::Max, grouped, QuantBlock),
+                    inv_scale = select(hi > lo, 255.f / (hi - lo), 0.f);
+
+            idx = arange<UInt32>(texels * channels);
+            texel = idx / channels;
+            block = fmadd(texel >> QuantShift, channels, idx - texel * channels);
+            Float32 q = round((value - gather<Float32>(lo, block)) *
+                              gather<Float32>(inv_scale, block));
+
+            m_quant_value = uint8_array_t<Storage>(clip(q, 0.f, 255.f));
+            m_quant_scale = Storage((hi - lo) * (1.f / 255.f));
+            m_quant_offset = Storage(lo);
+            m_value.array() = Storage();
+        }
+    }
+
+    /// Does the texture currently use the tiled storage layout?
+    bool tiled() const {
+        if constexpr (SupportsTiling)
+            return m_layout == TextureLayout::Tiled;
+        else
+            return false;
+    }
+
+    /// Map row-major texel indices to their position in the tiled layout
+    UInt32 tiled_index(const UInt32 &texel) const {
+        Array<Int32, Dimension> pos;
+        UInt32 rem = texel;
+        for (size_t i = 0; i < Dimension; ++i) {
+            uint32_t res = (uint32_t) m_shape[Dimension - 1 - i];
+            UInt32 next = rem / res;
+            pos[i] = Int32(rem - next * res);
+            rem = next;
+        }
+        return index(pos);
+    }
+
     /// Helper function to compute the array index for a given N-D position
     template <typename T>
     uint32_array_t<value_t<T>> index(const T &pos) const {
@@ -1561,7 +2193,17 @@ private:
         );
 
         Index index;
-        if constexpr (Dimension == 1) {
+        if (tiled()) {
+            // Tile index (row-major over tiles), then row-major within the tile
+            Index tile = 0, inner = 0;
+            for (size_t j = 0; j < Dimension; ++j) {
+                size_t i = Dimension - 1 - j;
+                Index p = Index(pos[i]);
+                tile = fmadd(tile, Index(m_tiles_opaque[i]), p >> TileShift);
+                inner = fmadd(inner, TileSize, p & (TileSize - 1));
+            }
+            index = fmadd(tile, TileTexels, inner);
+        } else if constexpr (Dimension == 1) {
             index = Index(pos.x());
         } else if constexpr (Dimension == 2) {
             index = Index(
@@ -1599,6 +2241,20 @@ private:
     mutable bool m_tensor_dirty = false;    /* Flag to indicate whether
                                                public-facing unpadded tensor
                                                needs to be updated */
+    mutable Storage m_mip_value;            /* Padded MIP levels 0, 1, ..,
+                                               concatenated */
+    mutable uint32_array_t<Storage> m_mip_offset; /* Texel offset of each
+                                               MIP level */
+    size_t m_mip_levels = 1;                /* Number of MIP levels */
+    TextureLayout m_layout = TextureLayout::Linear;
+    size_t m_tiles[Dimension] = {};         /* Tile count (width, height, ..) */
+    Array<UInt32, Dimension> m_tiles_opaque;
+    mutable bool m_mip_dirty = false;       /* Flag to indicate whether the
+                                               MIP pyramid must be rebuilt */
+    TextureFormat m_format = TextureFormat::Full;
+    uint8_array_t<Storage> m_quant_value;   /* Quantized texels (padded) */
+    Storage m_quant_scale;                  /* Per-block, per-channel scale */
+    Storage m_quant_offset;                 /* Per-block, per-channel offset */
 
 public:
     void
@@ -1611,7 +2267,9 @@ public:
             return;
 
         DRJIT_MAP(DR_TRAVERSE_MEMBER_RO, m_value, m_unpadded_value,
-                  m_resolution_opaque, m_inv_resolution);
+                  m_resolution_opaque, m_inv_resolution, m_mip_value,
+                  m_mip_offset, m_tiles_opaque, m_quant_value, m_quant_scale,
+                  m_quant_offset);
         if constexpr (HasCudaTexture) {
             uint32_t n_textures = 1 + ((uint32_t(m_channels) - 1) / 4);
             std::vector<uint32_t> indices(n_textures);
@@ -1629,7 +2287,9 @@ public:
             return;
 
         DRJIT_MAP(DR_TRAVERSE_MEMBER_RW, m_value, m_unpadded_value,
-                  m_resolution_opaque, m_inv_resolution);
+                  m_resolution_opaque, m_inv_resolution, m_mip_value,
+                  m_mip_offset, m_tiles_opaque, m_quant_value, m_quant_scale,
+                  m_quant_offset);
         if constexpr (HasCudaTexture) {
             uint32_t n_textures = 1 + ((uint32_t(m_channels) - 1) / 4);
             std::vector<uint32_t> indices(n_textures);
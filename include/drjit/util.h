@@ -353,4 +353,56 @@ void gather_packet_dynamic(size_t packet_size, Source &&source, const Index &ind
     }
 }
 
+/**
+ * \brief Blend several packet gathers when packet size is only known at runtime
+ *
+ * Accumulates <tt>weight[k] * source[index[k] * packet_size + i]</tt> into
+ * <tt>out[i]</tt> for all <tt>k < count</tt>. JIT arrays dispatch to
+ * <tt>ad_var_gather_footprint()</tt>, which represents the whole footprint by
+ * a single AD node.
+ */
+template <typename Value, typename Source, typename Index, typename Mask>
+void gather_footprint_dynamic(size_t packet_size, Source &&source, size_t count,
+                              const Index *index, const Value *weight,
+                              Value *out, const Mask &mask_ = true,
+                              ReduceMode mode = ReduceMode::Auto) {
+    // Broadcast mask to match shape of Index
+    mask_t<plain_t<Index>> mask = mask_;
+
+    if constexpr (is_jit_v<Value>) {
+        if ((packet_size & (packet_size - 1)) == 0) {
+            uint32_t *offsets = (uint32_t *) alloca(sizeof(uint32_t) * count);
+            uint64_t *weights = (uint64_t *) alloca(sizeof(uint64_t) * count),
+                     *res_indices = (uint64_t *) alloca(
+                         sizeof(uint64_t) * packet_size);
+
+            for (size_t k = 0; k < count; ++k) {
+                offsets[k] = index[k].index();
+                weights[k] = weight[k].index_combined();
+            }
+
+            ad_var_gather_footprint(packet_size, source.index_combined(), count,
+                                    offsets, weights, mask.index(), res_indices,
+                                    mode);
+
+            for (size_t i = 0; i < packet_size; ++i)
+                out[i] += Value::steal((typename Value::Index) res_indices[i]);
+            return;
+        }
+    }
+
+    Value *packet = (Value *) alloca(sizeof(Value) * packet_size);
+    for (size_t i = 0; i < packet_size; ++i)
+        new (&packet[i]) Value();
+
+    for (size_t k = 0; k < count; ++k) {
+        gather_packet_dynamic(packet_size, source, index[k], packet, mask, mode);
+        for (size_t i = 0; i < packet_size; ++i)
+            out[i] = fmadd(packet[i], weight[k], out[i]);
+    }
+
+    for (size_t i = 0; i < packet_size; ++i)
+        packet[i].~Value();
+}
+
 NAMESPACE_END(drjit)
@@ -23,6 +23,15 @@
  *   call to ``ad_traverse()``. This list is thread-local in contrast to the
  *   previous two data structures that are shared by all threads.
  *
+ * Modifications of the graph structure are protected by ``state.lock``.
+ * Reference counting is the most frequent operation by far, which is why
+ * variables live in pages with stable addresses and use atomic reference
+ * counts. This permits most reference count changes to proceed without
+ * acquiring the lock (see ``ad_var_inc_ref_impl()`` and
+ * ``ad_var_dec_ref_impl()``). Variable creation, edge creation, gradient
+ * accumulation and traversal still acquire it, hence threads that trace
+ * independent graphs concurrently continue to serialize on these steps.
+ *
  * To understand how everything fits together, start by looking at an arithmetic
  * operation like ``ad_var_add()``, which triggers ``ad_var_new()`` to allocate
  * a new variable. Next, look at and ``ad_traverse()``, which traverses the AD
@@ -54,7 +63,9 @@
 #include <tsl/robin_set.h>
 #include <tsl/robin_map.h>
 #include <nanobind/intrusive/counter.inl>
-#include <queue>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <string>
 
 #if defined(_WIN32)
@@ -225,6 +236,9 @@ struct Edge {
     bool is_custom = false;
 };
 
+// The flags occupy the padding after 'weight'
+static_assert(sizeof(Edge) == 32, "Edge: unexpected record size");
+
 /// Flags characterizing the 'Variable.flags' bit field
 enum VariableFlags : uint8_t {
     /// Was this AD node created while capturing symbolic computation in the
@@ -247,7 +261,10 @@ enum VariableFlags : uint8_t {
     LoopBoundary = 1 << 5,
 
     /// Does this variable store a cooperative vector?
-    CoopVec = 1 << 6
+    CoopVec = 1 << 6,
+
+    /// Are gathers tracking which blocks of the gradient they touch?
+    GradBlocks = 1 << 7
 };
 
 /**
@@ -265,8 +282,9 @@ enum VariableFlags : uint8_t {
  * linked list of edges (see also \ref Edge).
  */
 struct ADVariable {
-    /// Number of references to this AD variable
-    uint32_t ref_count = 0;
+    /// Number of references to this AD variable (may change without holding
+    /// ``state.lock``, see ``ad_var_dec_ref_fast()``)
+    std::atomic<uint32_t> ref_count { 0 };
 
     /// Link to the first forward edge at this node
     EdgeIndex next_fwd = 0;
@@ -293,7 +311,7 @@ struct ADVariable {
     uint8_t type = 0;
 
     /// Custom flags (see the 'VariableFlag' enum above)
-    uint8_t flags = 0;
+    std::atomic<uint8_t> flags { 0 };
 
     ADVariable() = default;
 
@@ -301,14 +319,18 @@ struct ADVariable {
     ADVariable &operator=(const ADVariable &) = delete;
 
     ADVariable(ADVariable &&v) noexcept
-        : ref_count(v.ref_count), next_fwd(v.next_fwd), next_bwd(v.next_bwd),
+        : ref_count(v.ref_count.load(std::memory_order_relaxed)),
+          next_fwd(v.next_fwd), next_bwd(v.next_bwd),
           grad(std::move(v.grad)), size(v.size), label(v.label),
-          counter(v.counter), backend(v.backend), type(v.type), flags(v.flags) {
+          counter(v.counter), backend(v.backend), type(v.type),
+          flags(v.flags.load(std::memory_order_relaxed)) {
         v.label = nullptr;
     }
 
     ADVariable &operator=(ADVariable &&v) noexcept {
-        ref_count = v.ref_count; next_fwd = v.next_fwd;
+        ref_count.store(v.ref_count.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+        next_fwd = v.next_fwd;
         next_bwd = v.next_bwd; grad = std::move(v.grad);
         size = v.size;
         if (flags & (uint8_t) VariableFlags::FreeLabel)
@@ -317,7 +339,8 @@ struct ADVariable {
         counter = v.counter;
         backend = v.backend;
         type = v.type;
-        flags = v.flags;
+        flags.store(v.flags.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
         return *this;
     }
 
@@ -430,20 +453,103 @@ struct ADVariable {
     }
 };
 
+/**
+ * \brief Growable array with stable element addresses
+ *
+ * Elements are stored in fixed-size pages that are allocated on demand and
+ * only released when the container is destroyed. In contrast to
+ * ``std::vector``, growing the container therefore never moves existing
+ * elements. This allows threads that own a reference to a variable to access
+ * its atomic fields without holding ``state.lock``, even while another thread
+ * concurrently allocates new variables.
+ *
+ * Growing and shrinking the container requires holding ``state.lock``.
+ */
+template <typename T, uint32_t PageShift = 12> struct PagedVector {
+    static constexpr uint32_t PageSize = 1u << PageShift;
+    static constexpr size_t MaxPages = ((size_t) 1 << 32) >> PageShift;
+
+    PagedVector() = default;
+    PagedVector(const PagedVector &) = delete;
+    PagedVector &operator=(const PagedVector &) = delete;
+
+    ~PagedVector() {
+        for (size_t i = 0; i < m_page_count; ++i)
+            delete[] m_pages[i].load(std::memory_order_relaxed);
+        free(m_pages);
+    }
+
+    T &operator[](size_t index) {
+        return m_pages[index >> PageShift].load(
+            std::memory_order_acquire)[index & (PageSize - 1)];
+    }
+
+    const T &operator[](size_t index) const {
+        return m_pages[index >> PageShift].load(
+            std::memory_order_acquire)[index & (PageSize - 1)];
+    }
+
+    size_t size() const { return m_size; }
+
+    /// Append a default-constructed element, allocating a page if needed
+    T &emplace_back() {
+        size_t index = m_size;
+        if (unlikely((index >> PageShift) == m_page_count)) {
+            if (unlikely(m_page_count == MaxPages))
+                ad_fail("PagedVector::emplace_back(): out of indices!");
+
+            /* The page table is large but mostly unused. ``calloc()`` maps
+               it lazily so that only touched parts consume memory. */
+            if (unlikely(!m_pages)) {
+                m_pages = (std::atomic<T *> *) calloc(MaxPages, sizeof(std::atomic<T *>));
+                if (!m_pages)
+                    ad_fail("PagedVector::emplace_back(): memory allocation failed!");
+            }
+
+            m_pages[m_page_count++].store(new T[PageSize],
+                                          std::memory_order_release);
+        }
+        m_size = index + 1;
+        return (*this)[index];
+    }
+
+    void resize(size_t size) {
+        while (m_size < size)
+            emplace_back();
+        m_size = size;
+    }
+
+private:
+    std::atomic<T *> *m_pages = nullptr;
+    size_t m_page_count = 0;
+    size_t m_size = 0;
+};
+
 /// Represents the global state of the AD system
 struct State {
     /// Lock protecting the state data structure
     Lock lock;
 
-    /// Hash table mapping variable IDs to variable instances
-    std::vector<ADVariable> variables;
+    /// Array storing variable instances, indexed by their AD index
+    PagedVector<ADVariable> variables;
 
     /// List of all edges (used and unused ones)
     std::vector<Edge> edges;
 
-    /// Sorted list of currently unused edges and vertices
-    std::priority_queue<ADIndex, std::vector<ADIndex>, std::greater<uint32_t>> unused_variables;
-    std::priority_queue<EdgeIndex, std::vector<EdgeIndex>, std::greater<uint32_t>> unused_edges;
+    /**
+     * \brief Free lists of currently unused variables and edges
+     *
+     * These are used as stacks, which makes acquiring and releasing an index
+     * an O(1) operation and preferentially hands out recently released (and
+     * hence likely cached) entries. The arrays are periodically compacted by
+     * ``ad_compact()`` to keep the set of used indices dense.
+     */
+    std::vector<ADIndex> unused_variables;
+    std::vector<EdgeIndex> unused_edges;
+
+    /// Number of releases since the last compaction of the free lists above
+    size_t released_variables = 0;
+    size_t released_edges = 0;
 
     /// Counter to establish an ordering among variables
     uint64_t counter = 0;
@@ -451,6 +557,9 @@ struct State {
     /// Are memory leak warnings enabled?
     bool leak_warnings = true;
 
+    /// Touched-block trackers of variables with the ``GradBlocks`` flag
+    tsl::robin_map<ADIndex, std::shared_ptr<struct GradBlocks>> grad_blocks;
+
     State() {
         variables.resize(1);
         edges.resize(1);
@@ -467,10 +576,11 @@ struct State {
                 size_t count = 0;
 
                 for (size_t i = 0; i < variables.size(); ++i) {
-                    if (variables[i].ref_count == 0)
+                    uint32_t ref_count = variables[i].ref_count.load();
+                    if (ref_count == 0)
                         continue;
 
-                    ad_warn(" - variable a%zu (%u references)", i, variables[i].ref_count);
+                    ad_warn(" - variable a%zu (%u references)", i, ref_count);
                     if (++count == 10) {
                         ad_warn(" - (skipping the rest)");
                         break;
@@ -506,6 +616,50 @@ struct Special {
     virtual ~Special() = default;
 };
 
+/**
+ * \brief Records which blocks of a gradient were touched by gathers
+ *
+ * Reverse-mode traversal of a gather accumulates gradients into a dense
+ * buffer, even when only a small fraction of the source (e.g., a large hash
+ * table) was accessed. When enabled via ``ad_var_set_grad_blocks()``, gather
+ * edges additionally mark the touched blocks, which lets consumers such as
+ * optimizers restrict their work to these blocks.
+ */
+struct GradBlocks {
+    GradBlocks(uint32_t block_size, size_t size)
+        : block_size(block_size),
+          block_count((uint32_t) ((size + block_size - 1) / block_size)) { }
+
+    /// Mark the blocks referenced by a set of gather offsets
+    void mark(JitBackend backend, uint32_t offset, uint32_t mask) {
+        if (!touched.valid())
+            touched = dr::zeros<JitMask>(block_count);
+
+        JitVar divisor = JitVar::steal(jit_var_u32(backend, block_size));
+        GenericArray<uint32_t> block = GenericArray<uint32_t>::steal(
+            jit_var_div(offset, divisor.index()));
+        dr::scatter(touched, JitMask(true), block, JitMask::borrow(mask));
+    }
+
+    /// Mark the blocks referenced by packet gathers of 'n' consecutive entries
+    void mark_packet(JitBackend backend, size_t n, uint32_t offset, uint32_t mask) {
+        JitVar n_v = JitVar::steal(jit_var_u32(backend, (uint32_t) n)),
+               first = JitVar::steal(jit_var_mul(offset, n_v.index()));
+        for (size_t k = 0; k < n; k += block_size) {
+            JitVar k_v = JitVar::steal(jit_var_u32(backend, (uint32_t) k)),
+                   entry = JitVar::steal(jit_var_add(first.index(), k_v.index()));
+            mark(backend, entry.index(), mask);
+        }
+        JitVar last_v = JitVar::steal(jit_var_u32(backend, (uint32_t) n - 1)),
+               last = JitVar::steal(jit_var_add(first.index(), last_v.index()));
+        mark(backend, last.index(), mask);
+    }
+
+    uint32_t block_size;
+    uint32_t block_count;
+    JitMask touched;
+};
+
 // Custom operation that copies the gradient from an input node
 struct CopyGrad : Special {
     void backward(ADVariable *, const ADVariable *target) override {
@@ -635,6 +789,9 @@ struct LocalState {
     /// Thread-local edge list used by ad_enqueue_*() and ad_traverse()
     std::vector<EdgeRef> todo;
 
+    /// Scratch space for the depth-first search in ad_dfs_fwd/bwd()
+    std::vector<ADIndex> dfs_stack;
+
     /// Nested scopes that restrict AD to specific variables
     std::vector<Scope> scopes;
 
@@ -649,18 +806,13 @@ static State state;
 static thread_local LocalState local_state;
 
 #if defined(DRJIT_SANITIZE_INTENSE)
-static void ad_sanitation_checkpoint_variables() {
-    state.variables.emplace_back();
-    state.variables.pop_back();
-    state.variables.shrink_to_fit();
-}
+// Variables have stable addresses (see 'PagedVector'), only edges can move
 static void ad_sanitation_checkpoint_edges() {
     state.edges.emplace_back();
     state.edges.pop_back();
     state.edges.shrink_to_fit();
 }
 static void ad_sanitation_checkpoint_both() {
-    ad_sanitation_checkpoint_variables();
     ad_sanitation_checkpoint_edges();
 }
 #endif
@@ -670,6 +822,77 @@ static void ad_sanitation_checkpoint_both() {
 static void ad_free(ADIndex, ADVariable *);
 static void ad_var_inc_ref_int(ADIndex index, ADVariable *v) noexcept;
 
+// ==========================================================================
+// Free list management
+// ==========================================================================
+
+/// Minimum number of releases between two compactions of a free list
+static constexpr size_t ad_compact_min_releases = 1024;
+
+/**
+ * \brief Compact the storage underlying a free list
+ *
+ * Trims entries from the end of ``storage`` that are on the free list
+ * ``unused`` and removes them from it. This keeps the arrays dense when large
+ * graphs are released. The function runs in time proportional to the size of
+ * the free list plus the number of trimmed entries. It is only invoked after
+ * at least as many releases as there are entries in the free list, hence the
+ * amortized cost per release remains O(1).
+ *
+ * Compaction may run in the middle of a recursive ``ad_free()``, where the
+ * entry being freed is already cleared but not yet released. Only trimming
+ * entries that are on the free list ensures that such entries (and all
+ * entries preceding them) are left alone.
+ *
+ * Compaction is skipped when ``JitFlag::ReuseIndices`` is disabled, since
+ * trimmed indices would be handed out again by subsequent allocations.
+ */
+template <typename Storage>
+static void ad_compact(Storage &storage, std::vector<uint32_t> &unused) {
+    if (!jit_flag(JitFlag::ReuseIndices))
+        return;
+
+    size_t size = storage.size(), new_size = size;
+    tsl::robin_set<uint32_t> released(unused.begin(), unused.end());
+
+    // Entry 0 is reserved and never released
+    while (new_size > 1 && released.count((uint32_t) (new_size - 1)))
+        new_size--;
+
+    if (new_size == size)
+        return;
+
+    unused.erase(std::remove_if(unused.begin(), unused.end(),
+                                [new_size](uint32_t i) { return i >= new_size; }),
+                 unused.end());
+    storage.resize(new_size);
+
+    ad_log("ad_compact(): trimmed %zu entries, %zu remain (%zu unused).",
+           size - new_size, new_size, unused.size());
+}
+
+/// Return an unused variable to the free list
+static void ad_var_release(ADIndex index) {
+    state.unused_variables.push_back(index);
+
+    if (unlikely(++state.released_variables >=
+                 std::max(state.unused_variables.size(), ad_compact_min_releases))) {
+        state.released_variables = 0;
+        ad_compact(state.variables, state.unused_variables);
+    }
+}
+
+/// Return an unused edge to the free list
+static void ad_edge_release(EdgeIndex index) {
+    state.unused_edges.push_back(index);
+
+    if (unlikely(++state.released_edges >=
+                 std::max(state.unused_edges.size(), ad_compact_min_releases))) {
+        state.released_edges = 0;
+        ad_compact(state.edges, state.unused_edges);
+    }
+}
+
 
 // ==========================================================================
 // Reference counting and variable cleanup
@@ -677,18 +900,22 @@ static void ad_var_inc_ref_int(ADIndex index, ADVariable *v) noexcept;
 
 static bool DRJIT_NOINLINE ad_decref_custom_op_output(ADVariable *);
 
+/// Increase the reference count of a variable. The caller must already own a
+/// reference or hold ``state.lock``.
 static void ad_var_inc_ref_int(ADIndex index, ADVariable *v) noexcept {
     DRJIT_MARK_USED(index);
-    ad_trace("ad_var_inc_ref(a%u): %u", index, v->ref_count + 1);
-    v->ref_count++;
+    uint32_t ref_count = v->ref_count.fetch_add(1, std::memory_order_relaxed);
+    DRJIT_MARK_USED(ref_count);
+    ad_trace("ad_var_inc_ref(a%u): %u", index, ref_count + 1);
 }
 
 static bool ad_var_dec_ref_int(ADIndex index, ADVariable *v) noexcept {
     DRJIT_MARK_USED(index);
-    ad_trace("ad_var_dec_ref(a%u): %u", index, v->ref_count - 1);
-    ad_assert(v->ref_count > 0, "ad_var_dec_ref_int(): reference count underflow");
+    uint32_t ref_count = v->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+    ad_trace("ad_var_dec_ref(a%u): %u", index, ref_count - 1);
+    ad_assert(ref_count > 0, "ad_var_dec_ref_int(): reference count underflow");
 
-    if (--v->ref_count > 0) {
+    if (ref_count > 1) {
         if (unlikely(v->flags & (uint8_t) VariableFlags::CustomOpOutput))
             return ad_decref_custom_op_output(v);
         else
@@ -740,7 +967,7 @@ static void ad_free_edges(uint32_t index, ADVariable *v) {
             }
         }
 
-        state.unused_edges.push(edge_id);
+        ad_edge_release(edge_id);
 
         edge_id = next_bwd;
     }
@@ -751,8 +978,11 @@ static void ad_free(ADIndex index, ADVariable *v) {
 
     ad_free_edges(index, v);
 
+    if (unlikely(v->flags & (uint8_t) VariableFlags::GradBlocks))
+        state.grad_blocks.erase(index);
+
     *v = ADVariable { };
-    state.unused_variables.push(index);
+    ad_var_release(index);
 }
 
 Index ad_var_copy_ref_impl(Index index) JIT_NOEXCEPT {
@@ -766,10 +996,9 @@ Index ad_var_copy_ref_impl(Index index) JIT_NOEXCEPT {
         if (!scopes.empty())
             scopes.back().maybe_disable(ad_index);
 
-        if (ad_index) {
-            std::lock_guard<Lock> guard(state.lock);
-            ad_var_inc_ref_int(ad_index, state[ad_index]);
-        }
+        // The caller owns a reference, no need to acquire 'state.lock'
+        if (ad_index)
+            ad_var_inc_ref_int(ad_index, &state.variables[ad_index]);
     }
 
     return combine(ad_index, jit_index);
@@ -781,10 +1010,9 @@ Index ad_var_inc_ref_impl(Index index) JIT_NOEXCEPT {
 
     jit_var_inc_ref(jit_index);
 
-    if (unlikely(ad_index)) {
-        std::lock_guard<Lock> guard(state.lock);
-        ad_var_inc_ref_int(ad_index, state[ad_index]);
-    }
+    // The caller owns a reference, no need to acquire 'state.lock'
+    if (unlikely(ad_index))
+        ad_var_inc_ref_int(ad_index, &state.variables[ad_index]);
 
     return index;
 }
@@ -794,8 +1022,33 @@ uint32_t ad_var_ref(uint64_t index) {
     uint32_t ad_index = ::ad_index(index);
     if (!ad_index)
         return 0;
-    std::lock_guard<Lock> guard(state.lock);
-    return state[ad_index]->ref_count;
+    return state.variables[ad_index].ref_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * \brief Try to decrease the reference count of a variable without acquiring
+ * ``state.lock``
+ *
+ * This succeeds as long as the caller does not hold the last reference and
+ * the variable requires no special handling upon release (this is the case
+ * for outputs of custom operations, see ``ad_decref_custom_op_output()``).
+ * Otherwise, the function returns ``false`` and the caller must fall back to
+ * ``ad_var_dec_ref_int()`` while holding the lock.
+ */
+static bool ad_var_dec_ref_fast(ADVariable *v) noexcept {
+    if (v->flags.load(std::memory_order_relaxed) &
+        (uint8_t) VariableFlags::CustomOpOutput)
+        return false;
+
+    uint32_t ref_count = v->ref_count.load(std::memory_order_relaxed);
+    while (ref_count > 1) {
+        if (v->ref_count.compare_exchange_weak(ref_count, ref_count - 1,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed))
+            return true;
+    }
+
+    return false;
 }
 
 void ad_var_dec_ref_impl(Index index) JIT_NOEXCEPT {
@@ -805,8 +1058,14 @@ void ad_var_dec_ref_impl(Index index) JIT_NOEXCEPT {
     jit_var_dec_ref(jit_index);
 
     if (unlikely(ad_index)) {
+        ADVariable *v = &state.variables[ad_index];
+        if (ad_var_dec_ref_fast(v)) {
+            ad_trace("ad_var_dec_ref(a%u): fast path", ad_index);
+            return;
+        }
+
         std::lock_guard<Lock> guard(state.lock);
-        ad_var_dec_ref_int(ad_index, state[ad_index]);
+        ad_var_dec_ref_int(ad_index, v);
     }
 }
 
@@ -844,14 +1103,10 @@ static std::pair<ADIndex, ADVariable *> ad_var_new(JitBackend backend,
         index = (ADIndex) state.variables.size();
         state.variables.emplace_back();
     } else {
-        index = unused.top();
-        unused.pop();
+        index = unused.back();
+        unused.pop_back();
     }
 
-#if defined(DRJIT_SANITIZE_INTENSE)
-    ad_sanitation_checkpoint_variables();
-#endif
-
     ADVariable *v = &state.variables[index];
     v->ref_count = 1;
     v->size = size;
@@ -880,8 +1135,8 @@ static EdgeIndex ad_edge_new() {
         index = (EdgeIndex) state.edges.size();
         state.edges.emplace_back();
     } else {
-        index = unused.top();
-        unused.pop();
+        index = unused.back();
+        unused.pop_back();
     }
 
 #if defined(DRJIT_SANITIZE_INTENSE)
@@ -1013,11 +1268,10 @@ DRJIT_NOINLINE Index ad_var_new_impl(const char *label, JitVar &&result,
     #pragma GCC diagnostic pop
 #endif
 
-    std::lock_guard<Lock> guard(state.lock);
-
     /* Potentially turn off derivative tracking for some of the operands if
        we're within a scope that enables/disables gradient propagation
-       (globally, or only for specific variables) */
+       (globally, or only for specific variables). Scopes are thread-local,
+       hence this step does not require holding 'state.lock'. */
     LocalState &ls = local_state;
     std::vector<Scope> &scopes = ls.scopes;
     if (!scopes.empty()) {
@@ -1043,6 +1297,8 @@ DRJIT_NOINLINE Index ad_var_new_impl(const char *label, JitVar &&result,
          reuse_indices = flags & (uint32_t) JitFlag::ReuseIndices;
 
     VarInfo info = jit_set_backend(result.index());
+
+    std::lock_guard<Lock> guard(state.lock);
     ReleaseHelper rh;
 
     /* Turn symbolic reads from non-symbolic variables into gathers,
@@ -1212,6 +1468,49 @@ void ad_clear_grad(Index index) {
     std::lock_guard<Lock> guard(state.lock);
     ADVariable *v = state[ad_index];
     v->grad = JitVar();
+
+    if (unlikely(v->flags & (uint8_t) VariableFlags::GradBlocks)) {
+        auto it = state.grad_blocks.find(ad_index);
+        if (it != state.grad_blocks.end())
+            it->second->touched = JitMask();
+    }
+}
+
+void ad_var_set_grad_blocks(Index index, uint32_t block_size) {
+    ADIndex ad_index = ::ad_index(index);
+    if (ad_index == 0)
+        return;
+
+    std::lock_guard<Lock> guard(state.lock);
+    ADVariable *v = state[ad_index];
+
+    if (block_size == 0) {
+        v->flags &= (uint8_t) ~VariableFlags::GradBlocks;
+        state.grad_blocks.erase(ad_index);
+    } else {
+        v->flags |= (uint8_t) VariableFlags::GradBlocks;
+        state.grad_blocks[ad_index] =
+            std::make_shared<GradBlocks>(block_size, v->size);
+    }
+}
+
+uint32_t ad_var_grad_blocks(Index index, uint32_t *block_size) {
+    ADIndex ad_index = ::ad_index(index);
+    if (ad_index == 0)
+        return 0;
+
+    std::lock_guard<Lock> guard(state.lock);
+    auto it = state.grad_blocks.find(ad_index);
+    if (it == state.grad_blocks.end())
+        return 0;
+
+    GradBlocks &blocks = *it->second;
+    if (block_size)
+        *block_size = blocks.block_size;
+    if (!blocks.touched.valid())
+        blocks.touched = dr::zeros<JitMask>(blocks.block_count);
+
+    return jit_var_inc_ref(blocks.touched.index());
 }
 
 void ad_accum_grad(Index index, JitIndex value) {
@@ -1227,12 +1526,12 @@ void ad_accum_grad(Index index, JitIndex value) {
     if (unlikely(ad_index == 0))
         return;
 
-    std::lock_guard<Lock> guard(state.lock);
-    ADVariable *v = state[ad_index];
-
     JitVar value_v = JitVar::borrow(value);
     size_t size_in = value_v.size();
 
+    std::lock_guard<Lock> guard(state.lock);
+    ADVariable *v = state[ad_index];
+
     if (v->size != size_in && size_in != 1 && size_in != 0 && v->size != 1)
         ad_raise("ad_accum_grad(): attempted to store a gradient of size "
                  "%zu into AD variable a%u, which has size %zu!",
@@ -1316,53 +1615,80 @@ Index ad_var_set_label(Index index, size_t argc, ...) {
 // Enqueuing of variables and edges
 // ==========================================================================
 
+/* The two functions below perform a depth-first search to collect all edges
+   reachable from a starting variable. They use an explicit stack instead of
+   recursion so that very deep graphs (e.g. unrolled loops with millions of
+   iterations) cannot overflow the call stack. The resulting 'todo' list holds
+   the edge ID, endpoints and ordering counters of each reachable edge, which
+   ``ad_traverse()`` sorts and then processes in a single pass. Processing an
+   edge still accesses 'state.edges' and 'state.variables' to fetch weights
+   and gradients. */
+
 /// Forward-mode DFS starting from 'index'
-static void ad_dfs_fwd(std::vector<EdgeRef> &todo, uint32_t index,
-                       ADVariable *v) {
-    DRJIT_MARK_USED(index);
+static void ad_dfs_fwd(LocalState &ls, ADIndex index) {
+    std::vector<EdgeRef> &todo = ls.todo;
+    std::vector<ADIndex> &stack = ls.dfs_stack;
+    stack.push_back(index);
 
-    uint32_t edge_id = v->next_fwd;
-    while (edge_id) {
-        Edge &edge = state.edges[edge_id];
+    while (!stack.empty()) {
+        index = stack.back();
+        stack.pop_back();
 
-        if (!edge.visited) {
-            edge.visited = true;
+        const ADVariable *v = state[index];
+        EdgeIndex edge_id = v->next_fwd;
 
-            ad_log("ad_dfs_fwd(): enqueuing edge a%u -> a%u", index,
-                   edge.target);
+        while (edge_id) {
+            Edge &edge = state.edges[edge_id];
 
-            ADVariable *v2 = state[edge.target];
-            ad_var_inc_ref_int(edge.target, v2);
-            todo.emplace_back(edge_id, edge.source, edge.target, v->counter,
-                              v2->counter);
+            if (!edge.visited) {
+                edge.visited = true;
 
-            ad_dfs_fwd(todo, edge.target, v2);
-        }
+                ad_log("ad_dfs_fwd(): enqueuing edge a%u -> a%u", index,
+                       edge.target);
+
+                ADVariable *v2 = state[edge.target];
+                ad_var_inc_ref_int(edge.target, v2);
+                todo.emplace_back(edge_id, edge.source, edge.target,
+                                  v->counter, v2->counter);
+                stack.push_back(edge.target);
+            }
 
-        edge_id = edge.next_fwd;
+            edge_id = edge.next_fwd;
+        }
     }
 }
 
 /// Reverse-mode DFS starting from 'index'
-static void ad_dfs_bwd(std::vector<EdgeRef> &todo, uint32_t index,
-                       ADVariable *v) {
-    uint32_t edge_id = v->next_bwd;
-    while (edge_id) {
-        Edge &edge = state.edges[edge_id];
+static void ad_dfs_bwd(LocalState &ls, ADIndex index) {
+    std::vector<EdgeRef> &todo = ls.todo;
+    std::vector<ADIndex> &stack = ls.dfs_stack;
+    stack.push_back(index);
 
-        if (!edge.visited) {
-            edge.visited = true;
+    while (!stack.empty()) {
+        index = stack.back();
+        stack.pop_back();
 
-            ad_log("ad_dfs_bwd(): enqueuing edge a%u -> a%u", index,
-                   edge.source);
+        ADVariable *v = state[index];
+        EdgeIndex edge_id = v->next_bwd;
 
-            ADVariable *v2 = state[edge.source];
-            ad_var_inc_ref_int(index, v);
-            todo.emplace_back(edge_id, edge.source, edge.target, v2->counter, v->counter);
-            ad_dfs_bwd(todo, edge.source, v2);
-        }
+        while (edge_id) {
+            Edge &edge = state.edges[edge_id];
 
-        edge_id = edge.next_bwd;
+            if (!edge.visited) {
+                edge.visited = true;
+
+                ad_log("ad_dfs_bwd(): enqueuing edge a%u -> a%u", index,
+                       edge.source);
+
+                const ADVariable *v2 = state[edge.source];
+                ad_var_inc_ref_int(index, v);
+                todo.emplace_back(edge_id, edge.source, edge.target,
+                                  v2->counter, v->counter);
+                stack.push_back(edge.source);
+            }
+
+            edge_id = edge.next_bwd;
+        }
     }
 }
 
@@ -1371,24 +1697,19 @@ void ad_enqueue(dr::ADMode mode, Index index) {
     if (ad_index == 0)
         return;
 
+    if (mode != dr::ADMode::Forward && mode != dr::ADMode::Backward)
+        ad_raise("ad_enqueue(): invalid mode specified!");
+
     ad_log("ad_enqueue_node(a%u, mode=%s)", ad_index,
            mode == dr::ADMode::Forward ? "forward" : "backward");
 
     LocalState &ls = local_state;
 
     std::lock_guard<Lock> guard(state.lock);
-    switch (mode) {
-        case dr::ADMode::Forward:
-            ad_dfs_fwd(ls.todo, ad_index, state[ad_index]);
-            break;
-
-        case dr::ADMode::Backward:
-            ad_dfs_bwd(ls.todo, ad_index, state[ad_index]);
-            break;
-
-        default:
-            ad_raise("ad_enqueue(): invalid mode specified!");
-    }
+    if (mode == dr::ADMode::Forward)
+        ad_dfs_fwd(ls, ad_index);
+    else
+        ad_dfs_bwd(ls, ad_index);
 }
 
 // ==========================================================================
@@ -1494,7 +1815,7 @@ static void ad_clear_todo(std::vector<EdgeRef> &todo, bool remove_edges) {
                       er.source, er.target);
 
             state.edges[er.id] = Edge { };
-            state.unused_edges.push(er.id);
+            ad_edge_release(er.id);
 
             source = state[er.source];
             ad_var_dec_ref_int(er.source, source);
@@ -1526,15 +1847,18 @@ void ad_traverse(dr::ADMode mode, uint32_t flags) {
     std::lock_guard<Lock> guard(state.lock);
     try {
         // Bring the edges into the appropriate order
-        std::sort(todo.begin(), todo.end(),
-                  [mode](const EdgeRef &a, const EdgeRef &b) {
-                      if (mode == dr::ADMode::Forward)
+        if (mode == dr::ADMode::Forward)
+            std::sort(todo.begin(), todo.end(),
+                      [](const EdgeRef &a, const EdgeRef &b) {
                           return std::tie(a.source_counter, a.target_counter) <
                                  std::tie(b.source_counter, b.target_counter);
-                      else
+                      });
+        else
+            std::sort(todo.begin(), todo.end(),
+                      [](const EdgeRef &a, const EdgeRef &b) {
                           return std::tie(a.target_counter, a.source_counter) >
                                  std::tie(b.target_counter, b.source_counter);
-                  });
+                      });
 
         // Any edges with an ID less than this value will be postponed
         uint64_t postpone_before = 0;
@@ -1954,8 +2278,10 @@ struct MaskGuard {
 
 struct Gather : Special {
     Gather(const GenericArray<uint32_t> &offset, const JitMask &mask,
-           ReduceMode reduce_mode = ReduceMode::Auto)
-        : offset(offset), mask(mask), reduce_mode(reduce_mode) {
+           ReduceMode reduce_mode = ReduceMode::Auto,
+           std::shared_ptr<GradBlocks> blocks = nullptr)
+        : offset(offset), mask(mask), reduce_mode(reduce_mode),
+          blocks(std::move(blocks)) {
         backend = jit_set_backend(mask.index()).backend;
         uint32_t mask_idx = jit_var_mask_peek(backend);
         if (!mask_idx)
@@ -1986,6 +2312,9 @@ struct Gather : Special {
             reduce_mode == ReduceMode::Permute ? ReduceOp::Identity
                                                : ReduceOp::Add,
             source_grad, target->grad, offset, mask, reduce_mode);
+
+        if (blocks)
+            blocks->mark(backend, offset.index(), mask.index());
     }
 
     void forward(const ADVariable *source, ADVariable *target) override {
@@ -1998,6 +2327,7 @@ struct Gather : Special {
     JitBackend backend;
     JitMask mask, mask_stack;
     ReduceMode reduce_mode;
+    std::shared_ptr<GradBlocks> blocks;
 };
 
 /// Edge representing a scatter operation
@@ -2373,6 +2703,25 @@ uint32_t ad_pred(uint32_t ad_index, uint32_t i_) {
     return state.edges[edge].source;
 }
 
+size_t ad_graph_bytes() {
+    std::lock_guard<Lock> guard(state.lock);
+    tsl::robin_set<uint32_t, UInt32Hasher> visited;
+    size_t result = 0;
+
+    for (const Edge &edge : state.edges) {
+        uint32_t index = edge.weight.index();
+
+        // Skip literals and arrays referenced by several edges
+        if (!index || jit_var_state(index) == VarState::Literal ||
+            !visited.insert(index).second)
+            continue;
+
+        result += jit_var_size(index) * jit_type_size(jit_var_type(index));
+    }
+
+    return result;
+}
+
 
 // ==========================================================================
 // Implementation of arithmetic operations and transcendental functions
@@ -3079,6 +3428,17 @@ uint64_t ad_var_repeat(Index index, uint32_t count, size_t max_size) {
 
 // ==========================================================================
 
+/// Return the touched-block tracker of a variable (if enabled)
+static std::shared_ptr<GradBlocks> ad_grad_blocks(ADIndex index) {
+    if (likely(!(state.variables[index].flags.load(std::memory_order_relaxed) &
+                 (uint8_t) VariableFlags::GradBlocks)))
+        return nullptr;
+
+    std::lock_guard<Lock> guard(state.lock);
+    auto it = state.grad_blocks.find(index);
+    return it != state.grad_blocks.end() ? it->second : nullptr;
+}
+
 uint64_t ad_var_gather(Index source, JitIndex offset, JitIndex mask, ReduceMode mode) {
     JitVar result = JitVar::steal(jit_var_gather(jit_index(source), offset, mask));
 
@@ -3093,7 +3453,8 @@ uint64_t ad_var_gather(Index source, JitIndex offset, JitIndex mask, ReduceMode
             std::move(result),
             SpecialArg(source,
                        new Gather(GenericArray<uint32_t>::borrow(offset),
-                                  JitMask::borrow(mask), mode)));
+                                  JitMask::borrow(mask), mode,
+                                  ad_grad_blocks(::ad_index(source)))));
     }
 }
 
@@ -3161,6 +3522,9 @@ public:
         source_grad = JitVar::steal(jit_var_scatter_packet(
             n, source_grad.index(), grad_out.data(), offset.index(),
             mask.index(), ReduceOp::Add, mode));
+
+        if (blocks)
+            blocks->mark_packet(m_backend, n, offset.index(), mask.index());
     }
 
     void add_output(uint32_t index) {
@@ -3172,6 +3536,8 @@ public:
 
     const char *name() const override { return "packet_gather"; }
 
+    std::shared_ptr<GradBlocks> blocks;
+
 private:
     JitVar offset, mask;
     ReduceMode mode;
@@ -3193,6 +3559,7 @@ void ad_var_gather_packet(size_t n, Index source, JitIndex offset,
         source = ad_var_memop_remap(source, true);
 
         ref<PacketGather> op = new PacketGather(offset, mask, mode);
+        op->blocks = ad_grad_blocks(source_ad);
         JitBackend backend = jit_set_backend(jit_index(source)).backend;
         op->add_index(backend, source_ad, true);
 
@@ -3212,6 +3579,249 @@ void ad_var_gather_packet(size_t n, Index source, JitIndex offset,
 
 // ==========================================================================
 
+/// Gather 'n' consecutive entries at 'offset' (packet gather if n > 1)
+static void footprint_gather(size_t n, uint32_t source, uint32_t offset,
+                             uint32_t mask, uint32_t *out) {
+    if (n == 1)
+        out[0] = jit_var_gather(source, offset, mask);
+    else
+        jit_var_gather_packet(n, source, offset, mask, out);
+}
+
+// A footprint gather computes a weighted sum of several packet gathers (e.g.,
+// the texels referenced by a texture lookup). Like PacketGather, it is
+// implemented as a CustomOp so that the whole footprint becomes a single node
+// of the AD graph instead of one gather per corner and one arithmetic node per
+// corner and channel. The generated code is unchanged: the primal computation
+// still performs one (packet) gather and 'n' multiply-adds per corner, and the
+// backward pass one (packet) scatter-add per corner. The corners of a texture
+// footprint are not contiguous in memory (rows differ, and wrapping may
+// separate neighbours), so fetching them with one memory operation would
+// need a multi-offset gather/scatter primitive that drjit-core lacks.
+class FootprintGather : public dr::detail::CustomOpBase {
+public:
+    FootprintGather(size_t count, const JitIndex *offsets,
+                    const Index *weights, JitIndex mask, ReduceMode mode)
+        : mask(JitVar::borrow(mask)), mode(mode) {
+        for (size_t k = 0; k < count; ++k) {
+            this->offsets.push_back(JitVar::borrow(offsets[k]));
+            this->weights.push_back(JitVar::borrow(jit_index(weights[k])));
+        }
+    }
+
+    ~FootprintGather() {
+        std::lock_guard<Lock> guard(state.lock);
+        for (ADIndex index : m_output_indices)
+            ad_var_dec_ref_int(index, state[index]);
+    }
+
+    void forward() override {
+        std::lock_guard<Lock> guard(state.lock);
+        size_t n = m_output_indices.size(), count = offsets.size();
+        index32_vector tmp(n, 0);
+        std::vector<JitVar> grad_out(n);
+
+        auto accum = [&](size_t ch, JitVar &&value) {
+            grad_out[ch] = grad_out[ch].valid()
+                ? JitVar::steal(jit_var_add(grad_out[ch].index(), value.index()))
+                : std::move(value);
+        };
+
+        const ADVariable *source = source_ad ? state[source_ad] : nullptr;
+        for (size_t k = 0; k < count; ++k) {
+            if (source && source->grad.valid()) {
+                footprint_gather(n, source->grad.index(), offsets[k].index(),
+                                 mask.index(), tmp.data());
+                for (size_t ch = 0; ch < n; ++ch) {
+                    accum(ch, JitVar::steal(jit_var_mul(
+                                  tmp[ch], weights[k].index())));
+                    jit_var_dec_ref(tmp[ch]);
+                    tmp[ch] = 0;
+                }
+            }
+
+            const ADVariable *w = weight_ad[k] ? state[weight_ad[k]] : nullptr;
+            if (w && w->grad.valid()) {
+                for (size_t ch = 0; ch < n; ++ch)
+                    accum(ch, JitVar::steal(jit_var_mul(
+                                  values[k * n + ch].index(), w->grad.index())));
+            }
+        }
+
+        for (size_t ch = 0; ch < n; ++ch) {
+            if (!grad_out[ch].valid())
+                continue;
+            ADVariable *v = state[m_output_indices[ch]];
+            v->accum(grad_out[ch], v->size);
+        }
+    }
+
+    void backward() override {
+        std::lock_guard<Lock> guard(state.lock);
+        size_t n = m_output_indices.size(), count = offsets.size();
+
+        std::vector<JitVar> grad_out(n);
+        bool any = false;
+        for (size_t ch = 0; ch < n; ++ch) {
+            ADVariable *v = state[m_output_indices[ch]];
+            if (v->grad.valid()) {
+                grad_out[ch] = v->grad;
+                any = true;
+            } else {
+                grad_out[ch] = scalar(m_backend, (VarType) v->type, 0.0);
+            }
+        }
+        if (!any)
+            return;
+
+        ADVariable *source = source_ad ? state[source_ad] : nullptr;
+        if (source) {
+            JitVar &source_grad = source->grad;
+            if (!source_grad.valid())
+                source_grad = scalar(m_backend, (VarType) source->type, 0.0);
+            if (source_grad.size() != source->size)
+                source_grad.resize(source->size);
+        }
+
+        index32_vector grad_k;
+        for (size_t k = 0; k < count; ++k) {
+            if (source) {
+                grad_k.clear();
+                for (size_t ch = 0; ch < n; ++ch)
+                    grad_k.push_back_steal(jit_var_mul(grad_out[ch].index(),
+                                                       weights[k].index()));
+
+                JitVar &source_grad = source->grad;
+                if (n == 1)
+                    source_grad = JitVar::steal(jit_var_scatter(
+                        source_grad.index(), grad_k[0], offsets[k].index(),
+                        mask.index(), ReduceOp::Add, mode));
+                else
+                    source_grad = JitVar::steal(jit_var_scatter_packet(
+                        n, source_grad.index(), grad_k.data(),
+                        offsets[k].index(), mask.index(), ReduceOp::Add, mode));
+
+                if (blocks)
+                    blocks->mark_packet(m_backend, n, offsets[k].index(),
+                                        mask.index());
+            }
+
+            ADVariable *w = weight_ad[k] ? state[weight_ad[k]] : nullptr;
+            if (w) {
+                JitVar dw;
+                for (size_t ch = 0; ch < n; ++ch) {
+                    JitVar t = JitVar::steal(jit_var_mul(
+                        grad_out[ch].index(), values[k * n + ch].index()));
+                    dw = dw.valid()
+                        ? JitVar::steal(jit_var_add(dw.index(), t.index()))
+                        : std::move(t);
+                }
+                w->accum(dw, w->size);
+            }
+        }
+    }
+
+    void add_output(uint32_t index) {
+        add_index(m_backend, index, false);
+
+        std::lock_guard<Lock> guard(state.lock);
+        ad_var_inc_ref_int(index, state[index]);
+    }
+
+    const char *name() const override { return "footprint_gather"; }
+
+    std::shared_ptr<GradBlocks> blocks;
+    ADIndex source_ad = 0;
+    std::vector<ADIndex> weight_ad;
+    std::vector<JitVar> values; // Gathered primal values (count x n)
+
+private:
+    std::vector<JitVar> offsets, weights;
+    JitVar mask;
+    ReduceMode mode;
+};
+
+void ad_var_gather_footprint(size_t n, Index source, size_t count,
+                             const JitIndex *offsets, const Index *weights,
+                             JitIndex mask, uint64_t *out, ReduceMode mode) {
+    if (n == 0 || (n & (n - 1)) != 0)
+        ad_raise("ad_var_gather_footprint(): the packet size must be a power "
+                 "of two!");
+
+    uint32_t *tmp = (uint32_t *) alloca(sizeof(uint32_t) * n);
+    std::vector<JitVar> values;
+    values.reserve(count * n);
+
+    // Primal computation: weighted sum of the gathered packets
+    std::vector<JitVar> result(n);
+
+    for (size_t k = 0; k < count; ++k) {
+        footprint_gather(n, jit_index(source), offsets[k], mask, tmp);
+        uint32_t w = jit_index(weights[k]);
+        for (size_t ch = 0; ch < n; ++ch) {
+            result[ch] = JitVar::steal(
+                result[ch].valid() ? jit_var_fma(tmp[ch], w, result[ch].index())
+                                   : jit_var_mul(tmp[ch], w));
+            values.push_back(JitVar::steal(tmp[ch]));
+        }
+    }
+
+    ADIndex source_ad = ad_index(source);
+    ADIndex *weight_ad = (ADIndex *) alloca(sizeof(ADIndex) * count);
+    bool weights_ad = false;
+
+    const std::vector<Scope> &scopes = local_state.scopes;
+    if (!scopes.empty())
+        scopes.back().maybe_disable(source_ad);
+
+    for (size_t k = 0; k < count; ++k) {
+        weight_ad[k] = ad_index(weights[k]);
+        if (!scopes.empty())
+            scopes.back().maybe_disable(weight_ad[k]);
+        weights_ad |= weight_ad[k] != 0;
+    }
+
+    if (source_ad || weights_ad) {
+        // Track implicit dependencies & potentially remap variable IDs
+        if (source_ad)
+            source = ad_var_memop_remap(source, true);
+
+        ref<FootprintGather> op =
+            new FootprintGather(count, offsets, weights, mask, mode);
+        JitBackend backend = jit_set_backend(jit_index(source)).backend;
+
+        if (source_ad && op->add_index(backend, source_ad, true)) {
+            op->source_ad = source_ad;
+            op->blocks = ad_grad_blocks(source_ad);
+        }
+
+        bool weights_tracked = false;
+        for (size_t k = 0; k < count; ++k) {
+            ADIndex index = op->add_index(backend, weight_ad[k], true)
+                                ? weight_ad[k] : 0;
+            op->weight_ad.push_back(index);
+            weights_tracked |= index != 0;
+        }
+
+        // The gathered values are only needed to differentiate the weights
+        if (weights_tracked)
+            op->values = std::move(values);
+
+        for (size_t ch = 0; ch < n; ++ch) {
+            out[ch] = ad_var_new(result[ch].index());
+            op->add_output(ad_index(out[ch]));
+        }
+
+        if (!ad_custom_op(op.get()))
+            ad_raise("ad_var_gather_footprint(): could not create CustomOp!");
+    } else {
+        for (size_t ch = 0; ch < n; ++ch)
+            out[ch] = result[ch].release();
+    }
+}
+
+// ==========================================================================
+
 static const char *mode_name[] = { "auto",        "direct", "local",
                                    "no_conflict", "expand", "permute" };
 static const char *red_name[] = { "identity", "add", "mul", "min", "max", "and", "or" };
@@ -3539,7 +4149,7 @@ const char *ad_var_whos() {
 
     std::vector<uint32_t> indices;
     for (size_t i = 1; i < state.variables.size(); ++i) {
-        if (state.variables[i].ref_count == 0)
+        if (state.variables[i].ref_count.load(std::memory_order_relaxed) == 0)
             continue;
         indices.emplace_back((uint32_t) i);
     }
@@ -3555,7 +4165,8 @@ const char *ad_var_whos() {
     for (uint32_t id : indices) {
         const ADVariable *v = state[id];
         buffer.fmt("  %-9i %-3s %12zu %8u    %s\n", id, type_name_short[v->type],
-                   v->size, v->ref_count, v->label ? v->label : "");
+                   v->size, v->ref_count.load(std::memory_order_relaxed),
+                   v->label ? v->label : "");
     }
     buffer.put("  =========================================================\n");
     return buffer.get();
@@ -3566,7 +4177,7 @@ const char *ad_var_graphviz() {
 
     std::vector<uint32_t> indices;
     for (size_t i = 1; i < state.variables.size(); ++i) {
-        if (state.variables[i].ref_count == 0)
+        if (state.variables[i].ref_count.load(std::memory_order_relaxed) == 0)
             continue;
         indices.emplace_back((uint32_t) i);
     }
@@ -4618,7 +5229,7 @@ static ADVariable *ad_custom_output_create(uint32_t index, ADVariable *v) {
     // Side effects can have a higher refcount
     ad_assert(v->ref_count == 3 || is_scatter,
               "ad_custom_op(): invalid reference count %u in variable a%u",
-              v->ref_count, index);
+              (uint32_t) v->ref_count, index);
 
     v->flags |= VariableFlags::CustomOpOutput;
 
@@ -4669,7 +5280,7 @@ bool ad_custom_op(dr::detail::CustomOpBase *op) {
         v0i = idx;
 
         for (uint32_t i: inputs) {
-            uint8_t &flags_ref = state[i]->flags;
+            std::atomic<uint8_t> &flags_ref = state[i]->flags;
             if (flags_ref & (uint8_t) VariableFlags::Visited) {
                 ad_log(" - in: a%u (ignored)", i);
                 continue;
@@ -4694,7 +5305,7 @@ bool ad_custom_op(dr::detail::CustomOpBase *op) {
         v1i = idx;
 
         for (uint32_t o: outputs) {
-            uint8_t & flags_ref = state[o]->flags;
+            std::atomic<uint8_t> &flags_ref = state[o]->flags;
             if (flags_ref & (uint8_t) VariableFlags::Visited) {
                 ad_log(" - out: a%u (ignored)", o);
                 continue;
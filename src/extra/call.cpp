@@ -14,7 +14,10 @@
 
 #include <drjit/autodiff.h>
 #include <drjit/custom.h>
+#include <tsl/robin_map.h>
 #include <algorithm>
+#include <memory>
+#include <mutex>
 #include <string>
 #include "common.h"
 
@@ -370,13 +373,68 @@ static void ad_call_symbolic(JitBackend backend, const char *variant,
     jit_new_scope(backend);
 }
 
+/**
+ * \brief Stably sort lanes by callable index and a coherence key
+ *
+ * Returns a permutation of the lanes ``0..n-1`` sorted by ``index`` and then
+ * by the full 32-bit ``coherence`` key (e.g., a Morton code), while
+ * preserving the original order of lanes with equal keys. The sort is an LSD
+ * radix sort with one bit per pass: it first processes the 32 bits of the
+ * coherence key and then the bits needed to represent ``max_id``. Each pass
+ * gathers the current key bit through the permutation, computes an exclusive
+ * prefix sum of the zero bits, and applies a permuting scatter.
+ */
+static JitVar ad_call_sort(JitBackend backend, const JitVar &index,
+                           uint32_t coherence, uint32_t max_id) {
+    uint32_t n = (uint32_t) index.size(), index_bits = 0;
+    while (index_bits < 32 && (max_id >> index_bits) != 0)
+        index_bits++;
+
+    JitVar zero = JitVar::steal(jit_var_u32(backend, 0)),
+           one = JitVar::steal(jit_var_u32(backend, 1)),
+           last = JitVar::steal(jit_var_u32(backend, n - 1)),
+           ctr = JitVar::steal(jit_var_counter(backend, n)),
+           mask = JitVar::steal(jit_var_bool(backend, true)),
+           perm = ctr;
+
+    for (uint32_t b = 0; b < 32 + index_bits; ++b) {
+        // Key bit of the lane currently at each position
+        uint32_t source = b < 32 ? coherence : index.index();
+        JitVar bit_shift = JitVar::steal(jit_var_u32(backend, b < 32 ? b : b - 32)),
+               key = JitVar::steal(jit_var_gather(source, perm.index(), mask.index())),
+               bit = JitVar::steal(jit_var_and(
+                   JitVar::steal(jit_var_shr(key.index(), bit_shift.index())).index(),
+                   one.index())),
+               is_zero = JitVar::steal(jit_var_eq(bit.index(), zero.index())),
+               zeros = JitVar::steal(jit_var_select(is_zero.index(), one.index(), zero.index()));
+
+        // Destination: zeros retain their order at the front, followed by ones
+        JitVar excl = JitVar::steal(jit_var_block_prefix_reduce(
+                   ReduceOp::Add, zeros.index(), n, true, false)),
+               n_zeros = JitVar::steal(jit_var_add(
+                   JitVar::steal(jit_var_gather(excl.index(), last.index(), mask.index())).index(),
+                   JitVar::steal(jit_var_gather(zeros.index(), last.index(), mask.index())).index())),
+               pos_one = JitVar::steal(jit_var_add(
+                   n_zeros.index(),
+                   JitVar::steal(jit_var_sub(ctr.index(), excl.index())).index())),
+               pos = JitVar::steal(jit_var_select(is_zero.index(), excl.index(), pos_one.index())),
+               perm_buf = JitVar::steal(jit_var_undefined(backend, VarType::UInt32, n));
+
+        perm = JitVar::steal(jit_var_scatter(perm_buf.index(), perm.index(),
+                                             pos.index(), mask.index(),
+                                             ReduceOp::Identity, ReduceMode::Permute));
+    }
+
+    return perm;
+}
+
 // Strategy 3: group the arguments and evaluate a kernel per callable
 static void ad_call_reduce(JitBackend backend, const char *variant,
                            const char *domain, const char *name,
                            size_t size, uint32_t index_, uint32_t mask_,
                            size_t callable_count, const vector<uint64_t> args_,
                            vector<uint64_t> &rv, ad_call_func func,
-                           void *payload) {
+                           void *payload, uint32_t coherence) {
     (void) name; // unused
     const char *domain_or_empty = domain ? domain : "",
                *separator = domain ? "::" : "";
@@ -415,6 +473,34 @@ static void ad_call_reduce(JitBackend backend, const char *variant,
     CallBucket *buckets =
         jit_var_call_reduce(backend, variant, domain, index.index(), &n_inst);
 
+    // Optionally reorder the lanes of each bucket following a coherence key.
+    // Sorted lanes form contiguous ranges per callable, ordered by ID and
+    // preceded by masked lanes (ID 0).
+    JitVar sorted;
+    vector<uint32_t> bucket_offset;
+    if (coherence && jit_var_size(coherence) == size && size > 1) {
+        vector<uint32_t> order;
+        uint32_t offset = (uint32_t) size, max_id = 0;
+        for (uint32_t i = 0; i < n_inst; ++i) {
+            if (buckets[i].id == 0)
+                continue;
+            order.push_back(i);
+            offset -= (uint32_t) jit_var_size(buckets[i].index);
+            max_id = std::max(max_id, buckets[i].id);
+        }
+
+        sorted = ad_call_sort(backend, index, coherence, max_id);
+        std::sort(order.begin(), order.end(), [buckets](uint32_t a, uint32_t b) {
+            return buckets[a].id < buckets[b].id;
+        });
+
+        bucket_offset.resize(n_inst);
+        for (uint32_t i : order) {
+            bucket_offset[i] = offset;
+            offset += (uint32_t) jit_var_size(buckets[i].index);
+        }
+    }
+
     index64_vector args2(args.size(), 0);
     args2.clear();
 
@@ -443,6 +529,16 @@ static void ad_call_reduce(JitBackend backend, const char *variant,
         // Fetch arguments
         scoped_set_mask mask_guard(
             backend, jit_var_mask_default(backend, wavefront_size));
+
+        JitVar index2_sorted;
+        if (sorted.valid()) {
+            JitVar ctr = JitVar::steal(jit_var_counter(backend, wavefront_size)),
+                   offset = JitVar::steal(jit_var_u32(backend, bucket_offset[i])),
+                   slot = JitVar::steal(jit_var_add(ctr.index(), offset.index()));
+            index2_sorted = JitVar::steal(jit_var_gather(
+                sorted.index(), slot.index(), memop_mask.index()));
+            index2 = index2_sorted.index();
+        }
         for (size_t j = 0; j < args.size(); ++j)
             args2.push_back_steal(ad_var_gather(
                 args[j], index2, memop_mask.index(), ReduceMode::Permute));
@@ -800,12 +896,146 @@ private:
     ad_call_cleanup m_cleanup;
 };
 
+/// Per call site state of the adaptive strategy (``symbolic == 2``)
+struct CallSiteInfo {
+    /// Number of calls at this site
+    uint32_t calls = 0;
+    /// Selected strategy (0: evaluated, 1: symbolic)
+    int symbolic = 1;
+};
+
+static std::mutex call_sites_lock;
+static tsl::robin_map<std::string, CallSiteInfo> call_sites;
+
+/// Re-select the strategy of an adaptive call site after this many calls
+static constexpr uint32_t call_site_interval = 64;
+
+/// Number of lane groups inspected to estimate divergence
+static constexpr uint32_t call_sample_groups = 64;
+
+/// Upper bound on the number of tracked call sites. Call sites are keyed by
+/// the identity of their callables, so transient callables (e.g., a
+/// ``functools.partial`` created on every call) would otherwise accumulate.
+static constexpr size_t call_sites_max = 1024;
+
+/* Thresholds of the strategy selection. Evaluated mode is chosen when the
+   sampled lane groups reference at least ``call_min_divergence`` distinct
+   callables on average, and when the average number of lanes per callable is
+   at least ``call_min_bucket_size``. These are estimates that have not been
+   calibrated on a particular device; the benchmark in ``docs/bench.rst``
+   measures both strategies to find the crossover point. */
+static constexpr double call_min_divergence = 2.0;
+static constexpr double call_min_bucket_size = 4096.0;
+
+/**
+ * \brief Select the strategy of an adaptive call by sampling its callable indices
+ *
+ * Symbolic mode runs all callables referenced by a SIMD group (a warp on CUDA,
+ * a vector on LLVM) one after the other, while evaluated mode launches one
+ * kernel per callable and pays for gathering arguments and scattering return
+ * values. This function gathers a few evenly spaced lane groups of the index,
+ * copies them to the host with a single read, and estimates the average
+ * number of distinct callables
+ * per group (the divergence) along with the number of referenced callables.
+ * Evaluated mode is chosen when the groups are divergent and the resulting
+ * kernels are large enough to amortize their launch.
+ */
+static int ad_call_select(JitBackend backend, const char *name,
+                          uint32_t index, size_t size) {
+    // Uniform index, no divergence
+    if (jit_var_size(index) != size || jit_var_state(index) == VarState::Literal)
+        return 1;
+
+    size_t group_size = backend == JitBackend::CUDA ? 32 : 16,
+           n_groups = std::min(size / group_size, (size_t) call_sample_groups);
+
+    if (n_groups == 0) {
+        n_groups = 1;
+        group_size = size;
+    }
+
+    // Gather the sampled lane groups into a contiguous array
+    size_t n = n_groups * group_size, stride = size / n_groups;
+    std::unique_ptr<uint32_t[]> sample(new uint32_t[n]);
+    for (size_t i = 0; i < n_groups; ++i)
+        for (size_t j = 0; j < group_size; ++j)
+            sample[i * group_size + j] = (uint32_t) (i * stride + j);
+
+    JitVar offset = JitVar::steal(jit_var_mem_copy(
+               backend, AllocType::Host, VarType::UInt32, sample.get(), n)),
+           active = JitVar::steal(jit_var_bool(backend, true)),
+           gathered = JitVar::steal(
+               jit_var_gather(index, offset.index(), active.index()));
+
+    void *ptr = nullptr;
+    JitVar data = JitVar::steal(jit_var_data(gathered.index(), &ptr));
+    jit_memcpy(backend, sample.get(), ptr, n * sizeof(uint32_t));
+
+    // Average number of distinct callables per group
+    size_t distinct = 0;
+    for (size_t i = 0; i < n_groups; ++i) {
+        uint32_t *start = sample.get() + i * group_size,
+                 *end = start + group_size;
+        std::sort(start, end);
+        distinct += (size_t) (std::unique(start, end) - start);
+    }
+    double divergence = (double) distinct / (double) n_groups;
+
+    // Number of referenced callables within the sample
+    std::sort(sample.get(), sample.get() + n);
+    size_t referenced = (size_t) (std::unique(sample.get(), sample.get() + n) - sample.get());
+    double bucket_size = (double) size / (double) referenced;
+
+    int symbolic = (divergence >= call_min_divergence &&
+                    bucket_size >= call_min_bucket_size) ? 0 : 1;
+
+    jit_log(LogLevel::Debug,
+            "ad_call(\"%s\"): divergence=%.2f, avg. bucket size=%.0f -> %s mode.",
+            name, divergence, bucket_size, symbolic ? "symbolic" : "evaluated");
+
+    return symbolic;
+}
+
+/// Return the strategy of an adaptive call site, re-selecting it periodically
+static int ad_call_adaptive(JitBackend backend, const char *variant,
+                            const char *domain, size_t callable_count,
+                            uint64_t site, const char *name, uint32_t index,
+                            size_t size) {
+    // Calls with a different set of callables must not share a decision
+    std::string key = std::to_string((int) backend) + "/" +
+                      (variant ? variant : "") + "/" +
+                      (domain ? domain : "") + "::" + name + "/" +
+                      std::to_string(callable_count) + "/" +
+                      std::to_string(site);
+    {
+        std::lock_guard<std::mutex> guard(call_sites_lock);
+        if (call_sites.size() >= call_sites_max &&
+            call_sites.find(key) == call_sites.end())
+            call_sites.clear();
+
+        // Sampling reads the index on the host. A frozen function would bake
+        // the result of this read into its recording and synchronize on every
+        // replay. Reuse the current decision instead.
+        CallSiteInfo &info = call_sites[key];
+        if (jit_flag(JitFlag::FreezingScope) ||
+            info.calls++ % call_site_interval != 0)
+            return info.symbolic;
+    }
+
+    int symbolic = ad_call_select(backend, name, index, size);
+
+    std::lock_guard<std::mutex> guard(call_sites_lock);
+    call_sites[key].symbolic = symbolic;
+    return symbolic;
+}
+
 // Generic checks, then forward either to ad_call_symbolic or ad_call_reduce
 bool ad_call(JitBackend backend, const char *variant, const char *domain,
              int symbolic, size_t callable_count,
              const char *name, bool is_getter, uint32_t index, uint32_t mask,
              const vector<uint64_t> &args, vector<uint64_t> &rv, void *payload,
-             ad_call_func func, ad_call_cleanup cleanup, bool ad) {
+             ad_call_func func, ad_call_cleanup cleanup, bool ad,
+             uint32_t coherence, uint64_t site) {
     try {
         const char *domain_or_empty = domain ? domain : "",
                    *separator = domain ? "::" : "";
@@ -815,6 +1045,10 @@ bool ad_call(JitBackend backend, const char *variant, const char *domain,
                       "'domain' parameter *or* 'callable_count', but not both",
                       domain_or_empty, separator, name);
 
+        // Adaptive calls inside a symbolic operation must be symbolic
+        if (symbolic == 2 && jit_flag(JitFlag::SymbolicScope))
+            symbolic = 1;
+
         if (symbolic == -1) {
             if (jit_flag(JitFlag::SymbolicScope)) {
                 // We're inside some other symbolic operation, cannot use evaluated mode
@@ -830,8 +1064,8 @@ bool ad_call(JitBackend backend, const char *variant, const char *domain,
             }
         }
 
-        if (symbolic != 0 && symbolic != 1)
-            jit_raise("ad_call(): 'symbolic' must be -1, 0, or 1!");
+        if (symbolic != 0 && symbolic != 1 && symbolic != 2)
+            jit_raise("ad_call(): 'symbolic' must be -1, 0, 1, or 2!");
 
         if (domain)
             callable_count = jit_registry_id_bound(variant, domain);
@@ -883,6 +1117,11 @@ bool ad_call(JitBackend backend, const char *variant, const char *domain,
             return true;
         }
 
+        if (symbolic == 2)
+            symbolic = is_getter ? 1 : ad_call_adaptive(backend, variant, domain,
+                                                        callable_count, site,
+                                                        name, index, size);
+
         vector<bool> rv_ad;
         dr::detail::ad_index32_vector implicit_in;
 
@@ -904,7 +1143,8 @@ bool ad_call(JitBackend backend, const char *variant, const char *domain,
                     "information on symbolic and evaluated calls, as well as their limitations.");
 
             ad_call_reduce(backend, variant, domain, name, size, index,
-                           mask, callable_count, args, rv, func, payload);
+                           mask, callable_count, args, rv, func, payload,
+                           coherence);
             ad = false; // derivative already tracked, no CustomOp needed
         }
 
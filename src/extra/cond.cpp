@@ -18,6 +18,9 @@
 #include <drjit-core/hash.h>
 #include <tsl/robin_map.h>
 #include <tsl/robin_set.h>
+#include <algorithm>
+#include <mutex>
+#include <string>
 
 namespace dr = drjit;
 
@@ -586,6 +589,158 @@ private:
     dr::vector<size_t> m_output_offsets;
 };
 
+/// Per call site branch statistics of conditional statements
+struct CondSite {
+    ADCondStats stats;
+
+    /// Lane counts (entries: true, false) of executions that did not count
+    /// their lanes on the host, accumulated on the device per backend
+    JitVar lanes[3];
+};
+
+static std::mutex cond_sites_lock;
+static tsl::robin_map<std::string, CondSite> cond_sites;
+
+/// Auto mode only considers evaluated mode for conditionals with this many lanes
+static constexpr size_t cond_auto_min_size = 4096;
+
+/// Auto mode selects evaluated mode when the less frequently taken branch
+/// has fewer than this fraction of the active lanes
+static constexpr double cond_auto_imbalance = 1.0 / 16.0;
+
+/**
+ * \brief Select the strategy of a conditional in auto mode
+ *
+ * Evaluates the branch masks and counts the lanes taking each branch using a
+ * single reduction and host read. Returns \c 2 or \c 3 when only the \c false
+ * or \c true branch has active lanes, which can then be executed directly.
+ * Otherwise, it returns \c 0 (evaluated mode) for large conditionals with a
+ * strongly unbalanced branch, and \c 1 (symbolic mode) in all other cases.
+ *
+ * The number of lanes serves as a proxy of the cost of the branches, which is
+ * not known before they are traced.
+ */
+static int ad_cond_select(JitBackend backend, const char *label,
+                          uint32_t true_mask, uint32_t false_mask, size_t size) {
+    // Count both branches at once: 'true' lanes in the low, 'false' lanes in
+    // the high 32 bits
+    JitVar one_t = JitVar::steal(jit_var_u64(backend, 1)),
+           one_f = JitVar::steal(jit_var_u64(backend, 1ull << 32)),
+           zero = JitVar::steal(jit_var_u64(backend, 0)),
+           value = JitVar::steal(jit_var_add(
+               JitVar::steal(jit_var_select(true_mask, one_t.index(), zero.index())).index(),
+               JitVar::steal(jit_var_select(false_mask, one_f.index(), zero.index())).index())),
+           count = JitVar::steal(
+               jit_var_reduce(backend, VarType::UInt64, ReduceOp::Add, value.index()));
+
+    uint64_t packed = 0;
+    jit_var_read(count.index(), 0, &packed);
+
+    uint32_t n_true = (uint32_t) packed,
+             n_false = (uint32_t) (packed >> 32),
+             n_active = n_true + n_false;
+
+    int result;
+    if (n_true == 0)
+        result = 2;
+    else if (n_false == 0)
+        result = 3;
+    else if (size >= cond_auto_min_size &&
+             std::min(n_true, n_false) < cond_auto_imbalance * n_active)
+        result = 0;
+    else
+        result = 1;
+
+    {
+        std::lock_guard<std::mutex> guard(cond_sites_lock);
+        ADCondStats &stats = cond_sites[label].stats;
+        stats.calls++;
+        stats.lanes_true += n_true;
+        stats.lanes_false += n_false;
+        if (result >= 2)
+            stats.skipped++;
+        else if (result == 0)
+            stats.evaluated++;
+    }
+
+    static const char *names[] = { "evaluated mode", "symbolic mode",
+                                   "false branch only", "true branch only" };
+    jit_log(LogLevel::Debug,
+            "ad_cond(\"%s\"): %u/%u active lanes take the true branch -> %s.",
+            label, n_true, n_active, names[result]);
+
+    return result;
+}
+
+/**
+ * \brief Record the execution of a conditional in symbolic or evaluated mode
+ *
+ * Counting lanes on the host would require a synchronization. Instead, the
+ * lanes are counted by a scatter-reduction into a small device array, which
+ * becomes part of the next kernel and is only read by \ref ad_cond_stats().
+ * This isn't possible when the conditional is nested within another symbolic
+ * operation, or when it is recorded by a frozen function. In these cases,
+ * only the execution itself is counted.
+ */
+static void ad_cond_record(JitBackend backend, const char *label, int symbolic,
+                           uint32_t cond, uint32_t true_mask, uint32_t false_mask) {
+    std::lock_guard<std::mutex> guard(cond_sites_lock);
+    CondSite &site = cond_sites[label];
+    site.stats.calls++;
+    if (symbolic == 0)
+        site.stats.evaluated++;
+
+    if (jit_flag(JitFlag::SymbolicScope) || jit_flag(JitFlag::FreezingScope))
+        return;
+
+    JitVar &lanes = site.lanes[(int) backend];
+    if (!lanes.valid()) {
+        uint64_t zero = 0;
+        lanes = JitVar::steal(jit_var_literal(backend, VarType::UInt64, &zero, 2));
+    }
+
+    JitVar one = JitVar::steal(jit_var_u64(backend, 1)),
+           slot_t = JitVar::steal(jit_var_u32(backend, 0)),
+           slot_f = JitVar::steal(jit_var_u32(backend, 1)),
+           slot = JitVar::steal(jit_var_select(cond, slot_t.index(), slot_f.index())),
+           active = JitVar::steal(jit_var_or(true_mask, false_mask));
+
+    lanes = JitVar::steal(jit_var_scatter(lanes.index(), one.index(),
+                                          slot.index(), active.index(),
+                                          ReduceOp::Add, ReduceMode::Local));
+}
+
+bool ad_cond_stats(const char *label, ADCondStats *stats) {
+    if (!label)
+        label = "unnamed";
+
+    std::lock_guard<std::mutex> guard(cond_sites_lock);
+    auto it = cond_sites.find(label);
+    if (it == cond_sites.end())
+        return false;
+
+    // Fold the lane counts accumulated on the device into the statistics
+    CondSite &site = it.value();
+    for (JitVar &lanes : site.lanes) {
+        if (!lanes.valid())
+            continue;
+        uint64_t n_true = 0, n_false = 0;
+        jit_var_read(lanes.index(), 0, &n_true);
+        jit_var_read(lanes.index(), 1, &n_false);
+        site.stats.lanes_true += (size_t) n_true;
+        site.stats.lanes_false += (size_t) n_false;
+        lanes = JitVar();
+    }
+
+    *stats = site.stats;
+    return true;
+}
+
+void ad_cond_stats_clear() {
+    std::lock_guard<std::mutex> guard(cond_sites_lock);
+    cond_sites.clear();
+}
+
 bool ad_cond(JitBackend backend, int symbolic, const char *label, void *payload,
              uint32_t cond, const dr::vector<uint64_t> &args,
              dr::vector<uint64_t> &rv, ad_cond_body body_cb,
@@ -611,8 +766,15 @@ bool ad_cond(JitBackend backend, int symbolic, const char *label, void *payload,
         }
     }
 
-    if (symbolic != 0 && symbolic != 1)
-        jit_raise("'symbolic' must equal 0, 1, or -1.");
+    // Auto mode must evaluate the condition, which isn't possible when
+    // nested within another symbolic operation. A frozen function would
+    // furthermore bake the lane counts into its recording.
+    if (symbolic == 2 && (jit_flag(JitFlag::SymbolicScope) ||
+                          jit_flag(JitFlag::FreezingScope)))
+        symbolic = 1;
+
+    if (symbolic < 0 || symbolic > 2)
+        jit_raise("'symbolic' must equal 0, 1, 2, or -1.");
 
     if (jit_var_state(cond) == VarState::Literal) {
         jit_log(LogLevel::InfoSym,
@@ -628,6 +790,23 @@ bool ad_cond(JitBackend backend, int symbolic, const char *label, void *payload,
            neg_mask = JitVar::steal(jit_var_not(cond)),
            false_mask = JitVar::steal(jit_var_mask_apply(neg_mask.index(), (uint32_t) size));
 
+    if (symbolic == 2) {
+        symbolic = ad_cond_select(backend, label, true_mask.index(),
+                                  false_mask.index(), size);
+
+        // Only one branch has active lanes, execute it directly
+        if (symbolic >= 2) {
+            bool value = symbolic == 3;
+            scoped_push_mask guard(
+                backend, value ? true_mask.index() : false_mask.index());
+            body_cb(payload, value, args, rv);
+            return true;
+        }
+    } else {
+        ad_cond_record(backend, label, symbolic, cond, true_mask.index(),
+                       false_mask.index());
+    }
+
     if (symbolic) {
         dr::vector<size_t> input_offsets, output_offsets;
         dr::detail::ad_index32_vector implicit_in, implicit_out;
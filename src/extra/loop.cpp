@@ -14,6 +14,9 @@
 
 #include "common.h"
 #include <drjit/custom.h>
+#include <tsl/robin_map.h>
+#include <algorithm>
+#include <mutex>
 #include <string>
 
 namespace dr = drjit;
@@ -145,7 +148,28 @@ static bool ad_loop_symbolic(JitBackend backend, const char *name,
     return needs_ad;
 }
 
-// Simple wavefront-style evaluated loop that masks inactive entries
+/// Execution policy of a named evaluated loop, see ad_loop_set_compress_policy()
+/// and ad_loop_set_persistent_iterations()
+struct LoopPolicy {
+    ADCompressPolicy policy = ADCompressPolicy::Always;
+    double param = 0.0;
+    uint32_t persistent_iterations = 1;
+};
+
+static std::mutex loop_info_lock;
+static tsl::robin_map<std::string, LoopPolicy> loop_policies;
+static tsl::robin_map<std::string, ADLoopStats> loop_stats;
+
+/// Look up the execution policy of a named evaluated loop
+static LoopPolicy ad_loop_policy(const char *name) {
+    std::lock_guard<std::mutex> guard(loop_info_lock);
+    auto it = loop_policies.find(name);
+    return it != loop_policies.end() ? it->second : LoopPolicy();
+}
+
+// Simple wavefront-style evaluated loop that masks inactive entries. On the
+// LLVM backend, each kernel launch may execute several iterations, which keeps
+// the loop state in registers in between (see ad_loop_set_persistent_iterations())
 static size_t ad_loop_evaluated_mask(JitBackend backend, const char *name,
                                      void *payload, ad_loop_read read_cb,
                                      ad_loop_write write_cb,
@@ -154,16 +178,24 @@ static size_t ad_loop_evaluated_mask(JitBackend backend, const char *name,
                                      JitVar active) {
     index64_vector indices2;
     JitVar active_it;
-    size_t it = 0;
+    size_t it = 0, launches = 0;
     bool grad_suspended = ad_grad_suspended();
     dr::vector<bool> copy_bit(indices1.size(), true);
 
+    uint32_t persistent = 1;
+    if (backend == JitBackend::LLVM)
+        persistent = ad_loop_policy(name).persistent_iterations;
+
     while (true) {
-        // Evaluate the loop state
-        jit_eval();
+        // Evaluate the loop state at the end of each kernel launch
+        bool launch_end = (it + 1) % persistent == 0;
+
+        if (it % persistent == 0) {
+            jit_eval();
 
-        if (!jit_var_any(active.index()))
-            break;
+            if (!jit_var_any(active.index()))
+                break;
+        }
 
         jit_log(LogLevel::InfoSym,
                 "ad_loop_evaluated(\"%s\"): executing loop iteration %zu.",
@@ -190,6 +222,20 @@ static size_t ad_loop_evaluated_mask(JitBackend backend, const char *name,
             ad_var_dec_ref(i2);
         }
 
+        // Intermediate iterations of a kernel launch keep the state symbolic
+        if (!launch_end) {
+            write_cb(payload, indices2, false);
+            indices1.release();
+            indices2.release();
+            read_cb(payload, indices1);
+
+            active_it = JitVar::borrow(cond_cb(payload));
+            active &= active_it;
+            continue;
+        }
+
+        launches++;
+
         for (size_t i = 0; i < indices2.size(); ++i) {
             // Potentially create an AD copy here (i.e., assign a new AD node
             // representing a copy of the original loop state). Note that this
@@ -240,7 +286,7 @@ static size_t ad_loop_evaluated_mask(JitBackend backend, const char *name,
             // The AD index of this was copied a number of times (see above for
             // the rationale). Let's now remove these again.
             uint32_t ad_index = (uint32_t) (indices1[i] >> 32);
-            for (uint32_t j = 0; j < it; ++j)
+            for (size_t j = 0; j < launches; ++j)
                 ad_index = ad_pred(ad_index, 0);
 
             uint64_t index_new = (((uint64_t) ad_index) << 32) | (uint32_t) indices1[i];
@@ -257,6 +303,40 @@ static size_t ad_loop_evaluated_mask(JitBackend backend, const char *name,
     return it;
 }
 
+/// Upper bound on the number of remaining iterations assumed by the cost model
+static constexpr double loop_cost_max_iterations = 64.0;
+
+/// Decide whether to compress the loop state in the current iteration
+static bool ad_loop_should_compress(const LoopPolicy &p, size_t it,
+                                    uint32_t size, uint32_t n_active,
+                                    uint32_t n_active_prev) {
+    if (n_active == 0 || n_active == size)
+        return n_active == 0;
+
+    switch (p.policy) {
+        case ADCompressPolicy::Threshold:
+            return n_active < (p.param > 0 ? p.param : 0.5) * size;
+
+        case ADCompressPolicy::Interval: {
+                size_t interval = p.param >= 1 ? (size_t) p.param : 4;
+                return it % interval == 0;
+            }
+
+        case ADCompressPolicy::CostModel: {
+                // Assume that the number of active entries decays geometrically
+                double rate = (double) n_active / (double) n_active_prev,
+                       remaining = rate < 1.0 ? 1.0 / (1.0 - rate)
+                                              : loop_cost_max_iterations;
+                remaining = std::min(remaining, loop_cost_max_iterations);
+                return (size - n_active) * remaining >=
+                       (p.param > 0 ? p.param : 1.0) * size;
+            }
+
+        default:
+            return true;
+    }
+}
+
 // Simple wavefront-style evaluated loop that progressively reduces the size
 // of the loop state to ignore inactive entries
 static size_t
@@ -323,7 +403,80 @@ ad_loop_evaluated_compress(JitBackend backend, const char *name, void *payload,
      */
     bool reduce_then_gather = backend == JitBackend::LLVM;
 
+    LoopPolicy policy = ad_loop_policy(name);
+
+    ADLoopStats stats;
+    uint32_t n_active_prev = size;
+    index64_vector indices2;
+
     while (true) {
+        // Other policies must count the active entries to decide whether to
+        // compress the loop state in this iteration
+        uint32_t n_active = size;
+        bool compress = true;
+        if (policy.policy != ADCompressPolicy::Always) {
+            JitVar one = JitVar::steal(jit_var_u32(backend, 1)),
+                   active_u32 = JitVar::steal(
+                       jit_var_select(active.index(), one.index(), zero.index())),
+                   count = JitVar::steal(jit_var_reduce(
+                       backend, VarType::UInt32, ReduceOp::Add, active_u32.index()));
+            jit_var_read(count.index(), 0, &n_active);
+            compress = ad_loop_should_compress(policy, it, size, n_active,
+                                               n_active_prev);
+            n_active_prev = std::max(n_active, 1u);
+        }
+
+        if (!compress) {
+            stats.active_fraction.push_back((float) n_active / (float) size);
+
+            jit_log(LogLevel::InfoSym,
+                    "ad_loop_evaluated(\"%s\"): executing loop iteration %zu "
+                    "without compression (%u/%u entries active).", name, ++it,
+                    n_active, size);
+
+            // Execute the loop body on the masked loop state
+            {
+                scoped_push_mask guard(backend, (uint32_t) active.index());
+                body_cb(payload);
+            }
+
+            read_cb(payload, indices2);
+
+            // Mask disabled lanes and write back
+            for (size_t i = 0; i < indices.size(); ++i) {
+                uint64_t i1 = indices[i], i2 = indices2[i];
+                if (skip[i] || i1 == i2 || jit_var_is_dirty((uint32_t) i2))
+                    continue;
+                indices2[i] = ad_var_select(active.index(), i2, i1);
+                ad_var_dec_ref(i2);
+            }
+
+            for (uint64_t &index: indices2) {
+                int unused = 0;
+                uint64_t index_new = ad_var_schedule_force(index, &unused);
+                ad_var_dec_ref(index);
+                index = index_new;
+            }
+
+            write_cb(payload, indices2, false);
+            indices.release();
+            indices2.release();
+            read_cb(payload, indices);
+
+            active &= JitVar::borrow(cond_cb(payload));
+            active.schedule_force_();
+            continue;
+        }
+
+        // Estimate the memory traffic of the compression step below
+        size_t entry_bytes = sizeof(uint32_t);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            if (!skip[i])
+                entry_bytes += jit_type_size(jit_var_type((uint32_t) indices[i]));
+        }
+        stats.compressions++;
+        stats.bytes_moved += entry_bytes * size;
+
         // Determine which entries aren't active, these must be written out
         JitVar not_active = JitVar::steal(jit_var_not(active.index()));
 
@@ -436,6 +589,7 @@ ad_loop_evaluated_compress(JitBackend backend, const char *name, void *payload,
                     "ad_loop_evaluated(\"%s\"): compressed loop state from %u "
                     "to %u entries.", name, size, size_next);
 
+        stats.active_fraction.push_back((float) size_next / (float) size);
         size = size_next;
         write_cb(payload, indices, false);
         indices.release();
@@ -456,6 +610,12 @@ ad_loop_evaluated_compress(JitBackend backend, const char *name, void *payload,
     if (it > 0)
         write_cb(payload, out_indices, false);
 
+    stats.iterations = it;
+    {
+        std::lock_guard<std::mutex> guard(loop_info_lock);
+        loop_stats[name] = std::move(stats);
+    }
+
     return it;
 }
 
@@ -1060,3 +1220,45 @@ bool ad_loop(JitBackend backend, int symbolic, int compress,
 
     return true; // Caller should directly call delete()
 }
+
+void ad_loop_set_compress_policy(const char *name, ADCompressPolicy policy,
+                                 double param) {
+    if (!name)
+        name = "unnamed";
+    if ((uint32_t) policy > (uint32_t) ADCompressPolicy::CostModel)
+        jit_raise("ad_loop_set_compress_policy(): invalid policy!");
+    if (param < 0)
+        jit_raise("ad_loop_set_compress_policy(): 'param' must be >= 0!");
+
+    std::lock_guard<std::mutex> guard(loop_info_lock);
+    LoopPolicy &p = loop_policies[name];
+    p.policy = policy;
+    p.param = param;
+}
+
+void ad_loop_set_persistent_iterations(const char *name, uint32_t iterations) {
+    if (!name)
+        name = "unnamed";
+    if (iterations == 0)
+        jit_raise("ad_loop_set_persistent_iterations(): 'iterations' must be >= 1!");
+
+    std::lock_guard<std::mutex> guard(loop_info_lock);
+    loop_policies[name].persistent_iterations = iterations;
+}
+
+bool ad_loop_stats(const char *name, ADLoopStats *stats) {
+    if (!name)
+        name = "unnamed";
+
+    std::lock_guard<std::mutex> guard(loop_info_lock);
+    auto it = loop_stats.find(name);
+    if (it == loop_stats.end())
+        return false;
+    *stats = it->second;
+    return true;
+}
+
+void ad_loop_stats_clear() {
+    std::lock_guard<std::mutex> guard(loop_info_lock);
+    loop_stats.clear();
+}
@@ -11,13 +11,26 @@
 #include <drjit/resample.h>
 #include <drjit/while_loop.h>
 #include <drjit/math.h>
+#include <drjit/packet.h>
 #include <nanothread/nanothread.h>
 #include <cmath>
 #include <algorithm>
 #include <any>
+#include <vector>
 
 NAMESPACE_BEGIN(drjit)
 
+/// Tables describing one resampling pass of the CPU implementation
+template <typename Accum> struct CPUPass {
+    uint32_t source_res;
+    uint32_t target_res;
+    uint32_t taps;
+    const uint32_t *offset;
+    const uint32_t *tap_pos;
+    const uint32_t *tap_count;
+    const Accum *weights;
+};
+
 /// Internal storage of 'Resampler' (hidden via pImpl pattern)
 struct Resampler::Impl {
     uint32_t source_res;
@@ -25,6 +38,16 @@ struct Resampler::Impl {
     uint32_t taps;
     unique_ptr<uint32_t[]> offset;
     unique_ptr<double[]> weights;
+
+    /* Tables used by the CPU implementation. They only list the taps with a
+       nonzero filter weight (and their position within the filter footprint)
+       so that the inner loop of ``Resampler::resample()`` neither checks for
+       zero weights nor multiplies infinite or NaN inputs by them. */
+    unique_ptr<uint32_t[]> cpu_tap_pos;
+    unique_ptr<uint32_t[]> cpu_taps;
+    unique_ptr<float[]> cpu_weights_f;
+    unique_ptr<double[]> cpu_weights_d;
+
     mutable std::any offset_cache;
     mutable std::any weights_cache;
 
@@ -85,6 +108,48 @@ struct Resampler::Impl {
             for (uint32_t l = 0; l < taps; l++)
                 weights[i * taps + l] *= normalization;
         }
+
+        cpu_tap_pos = unique_ptr<uint32_t[]>(new uint32_t[taps * target_res]);
+        cpu_taps = unique_ptr<uint32_t[]>(new uint32_t[target_res]);
+        cpu_weights_f = unique_ptr<float[]>(new float[taps * target_res]);
+        cpu_weights_d = unique_ptr<double[]>(new double[taps * target_res]);
+
+        for (uint32_t i = 0; i < target_res; i++) {
+            const double *w = weights.get() + i * taps;
+
+            // Compact the nonzero weights
+            uint32_t n = 0;
+            for (uint32_t l = 0; l < taps; l++) {
+                if (w[l] == 0)
+                    continue;
+                cpu_tap_pos[i * taps + n] = l;
+                cpu_weights_f[i * taps + n] = (float) w[l];
+                cpu_weights_d[i * taps + n] = w[l];
+                n++;
+            }
+            cpu_taps[i] = n;
+
+            for (uint32_t l = n; l < taps; l++) {
+                cpu_tap_pos[i * taps + l] = 0;
+                cpu_weights_f[i * taps + l] = 0.f;
+                cpu_weights_d[i * taps + l] = 0.0;
+            }
+        }
+    }
+
+    /// Return the CPU weight table of the desired precision
+    template <typename T> const T *get_cpu_weights() const {
+        if constexpr (std::is_same_v<T, double>)
+            return cpu_weights_d.get();
+        else
+            return cpu_weights_f.get();
+    }
+
+    /// Bundle the tables used by the CPU implementation
+    template <typename Accum> CPUPass<Accum> get_cpu_pass() const {
+        return { source_res,        target_res,     taps,
+                 offset.get(),      cpu_tap_pos.get(), cpu_taps.get(),
+                 get_cpu_weights<Accum>() };
     }
 
     /// Cast the resampling weights into a device array of the desired precision
@@ -202,74 +267,102 @@ Resampler::Resampler(uint32_t source_res, uint32_t target_res,
 
 Resampler::~Resampler() { }
 
+/**
+ * \brief Compute the entries [j0, j1) of one output row of a CPU pass
+ *
+ * 'in' and 'out' point to the first source/target element of the row.
+ * Adjacent elements along the resampled axis are 'stride' entries apart, and
+ * 'in' only stores the source elements starting at index 'source_base'.
+ *
+ * 'Width' adjacent entries of the 'stride' dimension are processed at once,
+ * which maps onto AVX2/NEON packet instructions when available.
+ */
+template <typename In, typename Out, typename Accum>
+static void resample_row(const CPUPass<Accum> &p, const In *in, Out *out,
+                         uint32_t j0, uint32_t j1, uint32_t stride,
+                         uint32_t source_base = 0) {
+    constexpr size_t Width = 32 / sizeof(Accum);
+    using PacketI = Packet<In, Width>;
+    using PacketO = Packet<Out, Width>;
+    using PacketA = Packet<Accum, Width>;
+
+    for (uint32_t j = j0; j < j1; ++j) {
+        const In *in_j = in + (size_t) (p.offset[j] - source_base) * stride;
+        const Accum *weights = p.weights + (size_t) j * p.taps;
+        const uint32_t *pos = p.tap_pos + (size_t) j * p.taps;
+        Out *out_j = out + (size_t) j * stride;
+        uint32_t taps = p.tap_count[j], k = 0;
+
+        // Vectorized part
+        for (; k + Width <= stride; k += Width) {
+            PacketA accum = zeros<PacketA>();
+            for (uint32_t l = 0; l < taps; ++l) {
+                PacketA value(load<PacketI>(in_j + (size_t) pos[l] * stride + k));
+                accum = fmadd(PacketA(weights[l]), value, accum);
+            }
+            if constexpr (std::is_same_v<Out, uint8_t>)
+                accum = clip(accum, 0.f, 255.f);
+            store(out_j + k, PacketO(accum));
+        }
+
+        // Remainder
+        for (; k < stride; ++k) {
+            Accum accum = 0;
+            for (uint32_t l = 0; l < taps; ++l)
+                accum = fmadd(weights[l], (Accum) in_j[(size_t) pos[l] * stride + k], accum);
+            if constexpr (std::is_same_v<Out, uint8_t>)
+                accum = clip(accum, 0.f, 255.f);
+            out_j[k] = (Out) accum;
+        }
+    }
+}
+
 /// Resample on the CPU and parallelize via the thread pool
 template <typename Value>
 void Resampler::resample(const Value *source, Value *target,
                          uint32_t source_size, uint32_t stride) const {
+    /* Accumulate in single precision unless the input is double precision.
+       The weights are stored in the same format to avoid conversions in the
+       inner loop. */
+    using Accum = std::conditional_t<std::is_same_v<Value, double>, double, float>;
+
     struct Task {
-        uint32_t source_res;
-        uint32_t target_res;
-        uint32_t taps;
+        CPUPass<Accum> pass;
         uint32_t stride;
         uint32_t inner_dim;
-        const uint32_t *offset;
-        const double *weights;
         const Value *in;
         Value *out;
         bool parallelize_outer;
     };
 
     auto callback = [](uint32_t outer, void *payload) {
-        using Accum =
-            std::conditional_t<sizeof(Value) < sizeof(float), float, Value>;
-
-        Task t = *(Task *) payload;
+        const Task &t = *(const Task *) payload;
         for (uint32_t inner = 0; inner < t.inner_dim; ++inner) {
             uint32_t i = t.parallelize_outer ? outer : inner,
                      j = t.parallelize_outer ? inner : outer;
 
-            const Value *in =
-                t.in + ((i * t.source_res + t.offset[j]) * t.stride);
-            Value *out = t.out + (i * t.target_res + j) * t.stride;
-
-            for (uint32_t k = 0; k < t.stride; ++k) {
-                Accum accum = 0;
-                for (uint32_t l = 0; l < t.taps; ++l) {
-                    double weight = t.weights[j * t.taps + l];
-                    if (weight != 0) {
-                        Value value = in[l * t.stride + k];
-                        accum =
-                            fmadd((Accum) weight, (Accum) value, accum);
-                    }
-                }
-                if constexpr (std::is_same_v<Value, uint8_t>)
-                    accum = clip(accum, (uint8_t) 0, (uint8_t) 255);
-                *out++ = (Value) accum;
-            }
+            resample_row(t.pass,
+                         t.in + (size_t) i * t.pass.source_res * t.stride,
+                         t.out + (size_t) i * t.pass.target_res * t.stride,
+                         j, j + 1, t.stride);
         }
     };
 
     uint32_t n_passes = source_size / (d->source_res * stride),
              target_size = n_passes * d->target_res * stride;
 
-    bool small_workload = std::max(source_size, target_size) < 256 * 256;
+    /* Run serially when the total number of multiply-adds is too small to
+       amortize the thread pool. Wide filters (e.g. when downsampling) make
+       small arrays expensive enough to benefit from it as well. */
+    uint64_t work = (uint64_t) std::max(source_size, target_size) * d->taps;
+    bool small_workload = work < 256 * 256;
     bool parallelize_outer = small_workload || n_passes >= pool_size();
 
     uint32_t outer_dim = parallelize_outer ? n_passes : d->target_res,
              inner_dim = parallelize_outer ? d->target_res : n_passes;
 
-    Task task {
-        d->source_res,
-        d->target_res,
-        d->taps,
-        stride,
-        inner_dim,
-        d->offset.get(),
-        d->weights.get(),
-        source,
-        target,
-        parallelize_outer
-    };
+    Task task { d->get_cpu_pass<Accum>(), stride, inner_dim,
+                source, target, parallelize_outer };
 
     if (small_workload) {
         for (uint32_t i = 0; i < outer_dim; ++i)
@@ -279,6 +372,197 @@ void Resampler::resample(const Value *source, Value *target,
     }
 }
 
+/// State shared by the work units of Resampler::resample_fused()
+template <typename Value, typename Accum> struct FusedCPUTask {
+    /// Per-axis tables ('taps == 0' if the axis is not resampled)
+    const CPUPass<Accum> *passes;
+    const uint32_t *shape;
+    const uint32_t *target_res;
+    uint32_t ndim;
+    /// Outermost resampled axis, which is split into tiles
+    uint32_t a0;
+    /// Number of target elements along 'a0' per tile, and tiles per slab
+    uint32_t tile, tiles;
+    /// Size of a source/target slice following 'a0'
+    uint32_t inner_src, inner_tgt;
+    /// Largest intermediate result while resampling a source slice
+    uint32_t inner_max;
+    const Value *in;
+    Value *out;
+};
+
+/**
+ * \brief Resample the axes following 'a0' of a single source slice
+ *
+ * The axes are processed from last to first, like a sequence of calls to
+ * Resampler::resample(). Intermediate results alternate between the two
+ * halves of 'tmp' (each of size 'inner_max'), and the result is written to
+ * 'out' in the accumulation precision.
+ */
+template <typename Value, typename Accum>
+static void resample_slice(const FusedCPUTask<Value, Accum> &t,
+                           const Value *in, Accum *out, Accum *tmp) {
+    // Resampled axis that is processed last
+    uint32_t last = t.a0;
+    for (uint32_t a = t.a0 + 1; a < t.ndim && last == t.a0; ++a) {
+        if (t.passes[a].taps)
+            last = a;
+    }
+
+    if (last == t.a0) {
+        for (uint32_t i = 0; i < t.inner_src; ++i)
+            out[i] = (Accum) in[i];
+        return;
+    }
+
+    const Accum *src = nullptr;
+    for (uint32_t a = t.ndim - 1, buf = 0; a > t.a0; --a) {
+        const CPUPass<Accum> &p = t.passes[a];
+        if (!p.taps)
+            continue;
+
+        // Axes before 'a' still have the source resolution
+        uint32_t n_passes = 1, stride = 1;
+        for (uint32_t b = t.a0 + 1; b < a; ++b)
+            n_passes *= t.shape[b];
+        for (uint32_t b = a + 1; b < t.ndim; ++b)
+            stride *= t.target_res[b];
+
+        Accum *dst = a == last ? out : tmp + (size_t) buf * t.inner_max;
+        size_t in_row = (size_t) p.source_res * stride,
+               out_row = (size_t) p.target_res * stride;
+
+        for (uint32_t i = 0; i < n_passes; ++i) {
+            if (src)
+                resample_row(p, src + i * in_row, dst + i * out_row, 0,
+                             p.target_res, stride);
+            else
+                resample_row(p, in + i * in_row, dst + i * out_row, 0,
+                             p.target_res, stride);
+        }
+
+        src = dst;
+        buf ^= 1;
+    }
+}
+
+template <typename Value>
+void Resampler::resample_fused(const Value *source, Value *target,
+                               const Resampler *const *resamplers,
+                               const uint32_t *shape, uint32_t ndim) {
+    using Accum = std::conditional_t<std::is_same_v<Value, double>, double, float>;
+    using Task = FusedCPUTask<Value, Accum>;
+
+    std::vector<CPUPass<Accum>> passes(ndim);
+    std::vector<uint32_t> target_res(ndim);
+    uint32_t a0 = ndim;
+
+    for (uint32_t a = 0; a < ndim; ++a) {
+        const Resampler *r = resamplers[a];
+        if (r) {
+            if (r->d->source_res != shape[a])
+                drjit_raise("Resampler::resample_fused(): resolution "
+                            "mismatch along axis %u!", a);
+            passes[a] = r->d->get_cpu_pass<Accum>();
+            target_res[a] = r->d->target_res;
+            if (a0 == ndim)
+                a0 = a;
+        } else {
+            passes[a] = { };
+            target_res[a] = shape[a];
+        }
+    }
+
+    uint32_t n_outer = 1, inner_src = 1, inner_tgt = 1;
+    for (uint32_t a = 0; a < ndim; ++a) {
+        if (a < a0)
+            n_outer *= shape[a];
+        else if (a > a0) {
+            inner_src *= shape[a];
+            inner_tgt *= target_res[a];
+        }
+    }
+
+    if (a0 == ndim) {
+        std::copy(source, source + n_outer, target);
+        return;
+    }
+
+    // Largest intermediate slice (the axes are processed from last to first)
+    uint32_t inner_max = inner_src;
+    for (uint32_t a = ndim - 1, size = inner_src; a > a0; --a) {
+        size = size / shape[a] * target_res[a];
+        inner_max = std::max(inner_max, size);
+    }
+
+    /* Split the target along axis 'a0' into tiles. The source elements
+       contributing to a tile are first resampled along the remaining axes
+       into a per-task buffer of roughly 64K entries, which stays in cache.
+       Neighboring tiles share 'taps - 1' of these elements, which are
+       resampled twice. */
+    const CPUPass<Accum> &p0 = passes[a0];
+    uint32_t rows = std::max(p0.taps, (uint32_t) (65536 / inner_tgt)),
+             tile = (uint32_t) std::max<uint64_t>(
+                 1, (uint64_t) (rows - p0.taps + 1) * p0.target_res / p0.source_res);
+    tile = std::min(tile, p0.target_res);
+
+    // Provide enough work units for the thread pool
+    uint32_t min_units = (uint32_t) pool_size() * 4;
+    if (n_outer < min_units) {
+        uint32_t tiles_min = (min_units + n_outer - 1) / n_outer;
+        tile = std::max(1u, std::min(tile, p0.target_res / tiles_min));
+    }
+
+    uint32_t tiles = (p0.target_res + tile - 1) / tile;
+
+    Task task { passes.data(), shape,     target_res.data(), ndim,
+                a0,            tile,      tiles,             inner_src,
+                inner_tgt,     inner_max, source,            target };
+
+    auto callback = [](uint32_t index, void *payload) {
+        const Task &t = *(const Task *) payload;
+        const CPUPass<Accum> &p = t.passes[t.a0];
+
+        uint32_t outer = index / t.tiles,
+                 j0 = (index - outer * t.tiles) * t.tile,
+                 j1 = std::min(j0 + t.tile, p.target_res);
+
+        // Range of source elements along 'a0' that contribute to the tile
+        uint32_t s0 = p.source_res, s1 = 0;
+        for (uint32_t j = j0; j < j1; ++j) {
+            uint32_t n = p.tap_count[j];
+            s0 = std::min(s0, p.offset[j]);
+            if (n)
+                s1 = std::max(s1, p.offset[j] + p.tap_pos[(size_t) j * p.taps + n - 1] + 1);
+        }
+        s0 = std::min(s0, s1);
+
+        unique_ptr<Accum[]> buf(
+            new Accum[(size_t) (s1 - s0) * t.inner_tgt + 2 * (size_t) t.inner_max]);
+        Accum *slices = buf.get(),
+              *tmp = slices + (size_t) (s1 - s0) * t.inner_tgt;
+
+        const Value *in = t.in + (size_t) outer * p.source_res * t.inner_src;
+        for (uint32_t s = s0; s < s1; ++s)
+            resample_slice(t, in + (size_t) s * t.inner_src,
+                           slices + (size_t) (s - s0) * t.inner_tgt, tmp);
+
+        resample_row(p, slices,
+                     t.out + (size_t) outer * p.target_res * t.inner_tgt,
+                     j0, j1, t.inner_tgt, s0);
+    };
+
+    uint32_t units = n_outer * tiles;
+    uint64_t work = (uint64_t) n_outer * p0.target_res * inner_tgt * p0.taps;
+
+    if (work < 256 * 256) {
+        for (uint32_t i = 0; i < units; ++i)
+            callback(i, &task);
+    } else {
+        task_submit_and_wait(nullptr, units, callback, &task);
+    }
+}
+
 template <typename Array>
 Array Resampler::resample_fwd(const Array &source, uint32_t stride) const {
     using Accum = std::conditional_t<sizeof(scalar_t<Array>) <= 4,
@@ -379,6 +663,142 @@ Array Resampler::resample_bwd(const Array &target, uint32_t stride) const {
     return Array(source);
 }
 
+/// Per-axis information used by Resampler::resample_fwd_fused()
+template <typename Accum, typename UInt32> struct FusedAxis {
+    /// Filter weights, or an invalid array if the axis is not resampled
+    Accum weights;
+    /// Per target element: index of the first weight in 'weights'
+    UInt32 weight_offset;
+    /// Number of filter taps (1 if the axis is not resampled)
+    uint32_t taps;
+    /// Distance between adjacent source elements along this axis
+    uint32_t source_stride;
+};
+
+/**
+ * \brief Decompose the output index of a fused resampling operation
+ *
+ * Computes per-axis weight offsets and returns the index of the first source
+ * element contributing to each output element. The remaining source elements
+ * are obtained by adding multiples of the per-axis source stride.
+ */
+template <typename Accum, typename UInt32>
+static UInt32 fused_setup(FusedAxis<Accum, UInt32> *axes,
+                          const UInt32 *offsets, const uint32_t *source_res,
+                          const uint32_t *target_res, uint32_t ndim,
+                          uint32_t target_size) {
+    UInt32 idx = arange<UInt32>(target_size),
+           base = zeros<UInt32>(target_size);
+
+    uint32_t source_stride = 1;
+    for (uint32_t a = ndim; a-- > 0;) {
+        FusedAxis<Accum, UInt32> &axis = axes[a];
+
+        // Extract the position along axis 'a'. Divisions are by scalar constants
+        UInt32 j;
+        if (a > 0) {
+            UInt32 q = idx / target_res[a];
+            j = fmadd(q, (uint32_t) (-(int32_t) target_res[a]), idx);
+            idx = std::move(q);
+        } else {
+            j = idx;
+        }
+
+        axis.source_stride = source_stride;
+        if (axis.weights.valid()) {
+            axis.weight_offset = j * axis.taps;
+            j = gather<UInt32>(offsets[a], j);
+        }
+
+        base = fmadd(j, source_stride, base);
+        source_stride *= source_res[a];
+    }
+
+    return base;
+}
+
+/// Compute the weight and source index of the flat filter tap 'l'
+template <typename Accum, typename UInt32>
+static std::pair<Accum, UInt32>
+fused_tap(const std::vector<FusedAxis<Accum, UInt32>> &axes, const UInt32 &base,
+          const UInt32 &l) {
+    Accum weight = scalar_t<Accum>(1);
+    UInt32 index = base, rem = l;
+
+    for (size_t a = axes.size(); a-- > 0;) {
+        const FusedAxis<Accum, UInt32> &axis = axes[a];
+        if (!axis.weights.valid())
+            continue;
+
+        UInt32 q = rem / axis.taps,
+               la = fmadd(q, (uint32_t) (-(int32_t) axis.taps), rem);
+        rem = std::move(q);
+
+        weight *= gather<Accum>(axis.weights, axis.weight_offset + la);
+        index = fmadd(la, axis.source_stride, index);
+    }
+
+    return { weight, index };
+}
+
+template <typename Array>
+Array Resampler::resample_fwd_fused(const Array &source,
+                                    const Resampler *const *resamplers,
+                                    const uint32_t *shape, uint32_t ndim) {
+    using Accum = std::conditional_t<sizeof(scalar_t<Array>) <= 4,
+                                     float32_array_t<Array>, Array>;
+    using UInt32 = uint32_array_t<Array>;
+    using Axis = FusedAxis<Accum, UInt32>;
+
+    std::vector<Axis> axes(ndim);
+    std::vector<UInt32> offsets(ndim);
+    std::vector<uint32_t> target_res(ndim);
+    uint32_t source_size = 1, target_size = 1, taps = 1;
+
+    for (uint32_t a = 0; a < ndim; ++a) {
+        const Resampler *r = resamplers[a];
+        if (r) {
+            if (r->d->source_res != shape[a])
+                drjit_raise("Resampler::resample_fwd_fused(): resolution "
+                            "mismatch along axis %u!", a);
+            axes[a].weights = r->d->get_weights<Accum>();
+            axes[a].taps = r->d->taps;
+            offsets[a] = r->d->get_offset<UInt32>();
+            target_res[a] = r->d->target_res;
+        } else {
+            axes[a].taps = 1;
+            target_res[a] = shape[a];
+        }
+        source_size *= shape[a];
+        target_size *= target_res[a];
+        taps *= axes[a].taps;
+    }
+
+    if ((uint32_t) source.size() != source_size)
+        drjit_raise("Resampler::resample_fwd_fused(): input size mismatch!");
+
+    UInt32 base = fused_setup(axes.data(), offsets.data(), shape,
+                              target_res.data(), ndim, target_size),
+           l = zeros<UInt32>(target_size);
+
+    Accum target = zeros<Accum>(target_size);
+    tie(l, target) = while_loop(
+        make_tuple(l, target),
+        // Loop condition
+        [taps](const UInt32 &l, const Accum &) {
+            return l < taps;
+        },
+        // Loop body
+        [source, axes, base](UInt32 &l, Accum &target) {
+            auto [weight, index] = fused_tap(axes, base, l);
+            Array value = gather<Array>(source, index, weight != Accum(0));
+            target = fmadd(weight, Accum(value), target);
+            l += 1;
+        });
+
+    return Array(target);
+}
+
 uint32_t Resampler::source_res() const { return d->source_res; }
 uint32_t Resampler::target_res() const { return d->target_res; }
 uint32_t Resampler::taps() const { return d->taps; }
@@ -387,6 +807,10 @@ template DRJIT_EXTRA_EXPORT void Resampler::resample(const uint8_t *, uint8_t *,
 template DRJIT_EXTRA_EXPORT void Resampler::resample(const half *, half *, uint32_t, uint32_t) const;
 template DRJIT_EXTRA_EXPORT void Resampler::resample(const float *, float *, uint32_t, uint32_t) const;
 template DRJIT_EXTRA_EXPORT void Resampler::resample(const double *, double *, uint32_t, uint32_t) const;
+template DRJIT_EXTRA_EXPORT void Resampler::resample_fused(const uint8_t *, uint8_t *, const Resampler *const *, const uint32_t *, uint32_t);
+template DRJIT_EXTRA_EXPORT void Resampler::resample_fused(const half *, half *, const Resampler *const *, const uint32_t *, uint32_t);
+template DRJIT_EXTRA_EXPORT void Resampler::resample_fused(const float *, float *, const Resampler *const *, const uint32_t *, uint32_t);
+template DRJIT_EXTRA_EXPORT void Resampler::resample_fused(const double *, double *, const Resampler *const *, const uint32_t *, uint32_t);
 
 #if defined(DRJIT_ENABLE_CUDA)
 template CUDAArray<half> Resampler::resample_fwd(const CUDAArray<half> &, uint32_t) const;
@@ -395,6 +819,9 @@ template CUDAArray<double> Resampler::resample_fwd(const CUDAArray<double> &, ui
 template CUDAArray<half> Resampler::resample_bwd(const CUDAArray<half> &, uint32_t) const;
 template CUDAArray<float> Resampler::resample_bwd(const CUDAArray<float> &, uint32_t) const;
 template CUDAArray<double> Resampler::resample_bwd(const CUDAArray<double> &, uint32_t) const;
+template CUDAArray<half> Resampler::resample_fwd_fused(const CUDAArray<half> &, const Resampler *const *, const uint32_t *, uint32_t);
+template CUDAArray<float> Resampler::resample_fwd_fused(const CUDAArray<float> &, const Resampler *const *, const uint32_t *, uint32_t);
+template CUDAArray<double> Resampler::resample_fwd_fused(const CUDAArray<double> &, const Resampler *const *, const uint32_t *, uint32_t);
 #endif
 
 #if defined(DRJIT_ENABLE_LLVM)
@@ -404,6 +831,9 @@ template LLVMArray<double> Resampler::resample_fwd(const LLVMArray<double> &, ui
 template LLVMArray<half> Resampler::resample_bwd(const LLVMArray<half> &, uint32_t) const;
 template LLVMArray<float> Resampler::resample_bwd(const LLVMArray<float> &, uint32_t) const;
 template LLVMArray<double> Resampler::resample_bwd(const LLVMArray<double> &, uint32_t) const;
+template LLVMArray<half> Resampler::resample_fwd_fused(const LLVMArray<half> &, const Resampler *const *, const uint32_t *, uint32_t);
+template LLVMArray<float> Resampler::resample_fwd_fused(const LLVMArray<float> &, const Resampler *const *, const uint32_t *, uint32_t);
+template LLVMArray<double> Resampler::resample_fwd_fused(const LLVMArray<double> &, const Resampler *const *, const uint32_t *, uint32_t);
 #endif
 
 NAMESPACE_END(drjit)
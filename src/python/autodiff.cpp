@@ -244,6 +244,44 @@ static void clear_grad(nb::handle dst) {
     traverse("drjit.clear_grad", cg, dst);
 }
 
+static void set_grad_blocks(nb::handle h, uint32_t block_size) {
+    struct SetGradBlocks : TraverseCallback {
+        uint32_t block_size;
+        SetGradBlocks(uint32_t block_size) : block_size(block_size) { }
+
+        void operator()(nb::handle h) override {
+            const ArraySupplement &s = supp(h.type());
+            if (s.is_diff && is_float(s))
+                ad_var_set_grad_blocks(s.index(inst_ptr(h)), block_size);
+        }
+    } sgb(block_size);
+
+    traverse("drjit.set_grad_blocks", sgb, h);
+}
+
+static nb::object grad_blocks(nb::handle h) {
+    nb::handle tp = h.type();
+    if (is_drjit_type(tp) && supp(tp).is_tensor)
+        return grad_blocks(nb::steal(supp(tp).tensor_array(h.ptr())));
+
+    if (!is_drjit_type(tp) || !supp(tp).is_diff || !is_float(supp(tp)) ||
+        supp(tp).ndim != 1)
+        nb::raise("drjit.grad_blocks(): expected a differentiable 1D "
+                  "floating point array or tensor!");
+
+    const ArraySupplement &s = supp(tp);
+    uint32_t index = ad_var_grad_blocks(s.index(inst_ptr(h)), nullptr);
+    if (!index)
+        return nb::none();
+
+    nb::handle mask_tp = s.mask;
+    nb::object result = nb::inst_alloc(mask_tp);
+    supp(mask_tp).init_index(index, inst_ptr(result));
+    nb::inst_mark_ready(result);
+    jit_var_dec_ref(index);
+    return result;
+}
+
 static void accum_grad(nb::handle target, nb::handle source) {
     struct SetGrad : TraversePairCallback {
         void operator()(nb::handle h1, nb::handle h2) override {
@@ -666,6 +704,9 @@ void export_autodiff(nb::module_ &m) {
      .def("accum_grad", &::accum_grad, "target"_a, "source"_a, doc_accum_grad,
           nb::sig("def accum_grad(target: T, source: T) -> None"))
      .def("clear_grad", &::clear_grad, doc_clear_grad)
+     .def("set_grad_blocks", &set_grad_blocks, "arg"_a, "block_size"_a,
+          doc_set_grad_blocks)
+     .def("grad_blocks", &grad_blocks, "arg"_a, doc_grad_blocks)
      .def("replace_grad", &::replace_grad, doc_replace_grad,
           nb::sig("def replace_grad(arg0: T, arg1: T, /) -> None"))
      .def("grad", &::grad, "arg"_a, "preserve_type"_a = true, doc_grad,
@@ -474,6 +474,8 @@ void export_detail(nb::module_ &) {
         .value("HostPinned", AllocType::HostPinned)
         .value("Device", AllocType::Device);
 
+    d.def("ad_graph_bytes", &ad_graph_bytes,
+          "Estimate the memory (in bytes) retained by the AD graph");
     d.def("malloc_watermark", &jit_malloc_watermark,
           "Return the peak memory usage (watermark) for a given allocation type");
     d.def("malloc_clear_statistics", &jit_malloc_clear_statistics,
@@ -127,6 +127,7 @@
 #include <drjit/traversable_base.h>
 #include <nanobind/nanobind.h>
 #include <xxh3.h>
+#include <chrono>
 
 #include "autodiff.h"
 #include "base.h"
@@ -214,21 +215,24 @@ struct state_unlock_guard {
 
 using namespace detail;
 
-bool Layout::operator==(const Layout &rhs) const {
-    if (((bool) this->type != (bool) rhs.type) || !(this->type.equal(rhs.type)))
+/// Compare two Python objects, skipping the comparison if they are identical
+static bool py_equal(nb::handle a, nb::handle b) {
+    if (a.is(b))
+        return true;
+    if (!a || !b)
         return false;
+    return a.equal(b);
+}
 
+bool Layout::operator==(const Layout &rhs) const {
+    // Check the integer fields first. Python objects are usually identical
+    // across calls, which is detected without a rich comparison.
     if (this->num != rhs.num)
         return false;
 
     if (this->fields.size() != rhs.fields.size())
         return false;
 
-    for (uint32_t i = 0; i < this->fields.size(); ++i) {
-        if (!(this->fields[i].equal(rhs.fields[i])))
-            return false;
-    }
-
     if (this->index != rhs.index)
         return false;
 
@@ -241,8 +245,15 @@ bool Layout::operator==(const Layout &rhs) const {
     if (this->vt != rhs.vt)
         return false;
 
-    if (((bool) this->py_object != (bool) rhs.py_object) ||
-        !this->py_object.equal(rhs.py_object))
+    if (!py_equal(this->type, rhs.type))
+        return false;
+
+    for (uint32_t i = 0; i < this->fields.size(); ++i) {
+        if (!py_equal(this->fields[i], rhs.fields[i]))
+            return false;
+    }
+
+    if (!py_equal(this->py_object, rhs.py_object))
         return false;
 
     return true;
@@ -1603,6 +1614,9 @@ bool log_diff(LogLevel level, const FlatVariables &curr,
 
 size_t FlatVariablesHasher::operator()(
     const std::shared_ptr<FlatVariables> &key) const {
+    if (key->hash)
+        return key->hash;
+
     ProfilerPhase profiler("hash");
     // Hash the layout
 
@@ -1685,9 +1699,26 @@ size_t FlatVariablesHasher::operator()(
                        ((uint64_t) layout.vs << 4) | ((uint64_t) layout.vt));
     }
 
-    uint64_t hash = XXH3_64bits(data.data(), data.size());
+    uint64_t hash = XXH3_64bits(data.data(), data.size() * sizeof(uint64_t));
+
+    // Reserve 0 to mark hashes that were not computed yet
+    key->hash = hash ? (size_t) hash : 1;
+
+    return key->hash;
+}
+
+size_t FlatVariables::memory_usage() const {
+    size_t result = sizeof(FlatVariables) +
+                    (variables.size() + sizes.size()) * sizeof(uint32_t) +
+                    (index_to_slot.size() + size_to_slot.size()) *
+                        2 * sizeof(uint32_t) +
+                    layout.size() * sizeof(Layout) +
+                    var_layout.size() * sizeof(VarLayout);
 
-    return hash;
+    for (const Layout &layout : this->layout)
+        result += layout.fields.size() * sizeof(nb::object);
+
+    return result;
 }
 
 /*
@@ -1789,6 +1820,19 @@ nb::object FunctionRecording::record(nb::callable func,
         out_variables.record_jit_variables();
     }
 
+    // Estimate the memory footprint, skipping inputs that were not modified
+    tsl::robin_set<uint32_t, UInt32Hasher> inputs(
+        in_variables.variables.begin(), in_variables.variables.end());
+    size_bytes = 0;
+    for (uint32_t i = 0; i < out_variables.var_layout.size(); i++) {
+        const VarLayout &layout = out_variables.var_layout[i];
+        if (inputs.count(out_variables.variables[i]))
+            continue;
+        size_bytes += (size_t) out_variables.sizes[layout.size_index] *
+                      jit_type_size(layout.vt);
+    }
+    size_bytes += in_variables.memory_usage() + out_variables.memory_usage();
+
     jit_freeze_pause(backend);
 
     if ((out_variables.variables.size() > 0 &&
@@ -2037,28 +2081,27 @@ nb::object FrozenFunction::operator()(nb::dict input) {
                  "freeze(): Cannot infer backend without providing input "
                  "variable to frozen function!");
 
-        auto it = this->recordings.find(in_variables);
+        // Fast path: compare against the key of the previous call, whose hash
+        // is memoized. This avoids hashing the layout of the new input, but
+        // the comparison still visits every layout entry. The input traversal
+        // above, which builds these entries, runs on every call regardless.
+        RecordingMap::iterator it;
+        if (last_key && *in_variables == *last_key)
+            it = this->recordings.find(last_key);
+        else
+            it = this->recordings.find(in_variables);
 
         // Evict the least recently used recording if the cache is "full"
         if (max_cache_size > 0 &&
             recordings.size() >= (uint32_t) max_cache_size &&
             it == this->recordings.end()) {
-
-            uint32_t lru_last_used        = UINT32_MAX;
-            RecordingMap::iterator lru_it = recordings.begin();
-
-            for (auto it = recordings.begin(); it != recordings.end(); it++) {
-                auto &recording = it.value();
-                if (recording->last_used < lru_last_used) {
-                    lru_last_used = recording->last_used;
-                    lru_it        = it;
-                }
-            }
-            recordings.erase(lru_it);
-
+            evict((size_t) max_cache_size - 1);
             it = this->recordings.find(in_variables);
         }
 
+        FunctionRecording *used = nullptr;
+        auto start = std::chrono::steady_clock::now();
+
         if (it == this->recordings.end()) {
             {
                 // TODO: single traverse
@@ -2071,6 +2114,7 @@ nb::object FrozenFunction::operator()(nb::dict input) {
             // FunctionRecording recording;
             auto recording       = std::make_unique<FunctionRecording>();
             recording->last_used = call_counter - 1;
+            used                 = recording.get();
 
             try {
                 result = recording->record(func, this, input, *in_variables);
@@ -2092,6 +2136,7 @@ nb::object FrozenFunction::operator()(nb::dict input) {
             in_variables->release();
 
             this->prev_key = in_variables;
+            this->last_key = in_variables;
             this->recordings.insert(
                 { std::move(in_variables), std::move(recording) });
 
@@ -2099,6 +2144,9 @@ nb::object FrozenFunction::operator()(nb::dict input) {
             FunctionRecording *recording = it.value().get();
 
             recording->last_used = call_counter - 1;
+            recording->n_replays++;
+            used = recording;
+            last_key = it.key();
 
             try {
                 result = recording->replay(func, this, input, *in_variables);
@@ -2110,17 +2158,86 @@ nb::object FrozenFunction::operator()(nb::dict input) {
             // Drop references to variables
             in_variables->release();
         }
+
+        double elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start).count();
+        if (used->n_replays > 0)
+            used->replay_time += elapsed;
+        else
+            used->record_time += elapsed;
+
+        used->priority = evict_clock + (double) (used->n_replays + 1) /
+                                           (double) std::max(used->size_bytes,
+                                                             (size_t) 1);
+
+        if (max_cache_bytes >= 0)
+            evict(SIZE_MAX, used);
     }
     ad_traverse(drjit::ADMode::Backward,
                 (uint32_t) drjit::ADFlag::ClearVertices);
     return result;
 }
 
+size_t FrozenFunction::cache_bytes() const {
+    size_t result = 0;
+    for (auto &it : recordings)
+        result += it.second->size_bytes;
+    return result;
+}
+
+void FrozenFunction::evict(size_t max_count, const FunctionRecording *keep) {
+    size_t total = cache_bytes();
+
+    while (!recordings.empty()) {
+        bool over_count = recordings.size() > max_count,
+             over_bytes = max_cache_bytes >= 0 &&
+                          total > (size_t) max_cache_bytes;
+        if (!over_count && !over_bytes)
+            break;
+
+        // Least recently used recording for the count limit, lowest priority
+        // (then least recently used) one for the byte budget
+        RecordingMap::iterator victim = recordings.end();
+        for (auto it = recordings.begin(); it != recordings.end(); it++) {
+            const FunctionRecording *r = it.value().get();
+            if (r == keep)
+                continue;
+            if (victim == recordings.end()) {
+                victim = it;
+                continue;
+            }
+            const FunctionRecording *v = victim.value().get();
+            bool better = over_count
+                ? r->last_used < v->last_used
+                : (r->priority < v->priority ||
+                   (r->priority == v->priority && r->last_used < v->last_used));
+            if (better)
+                victim = it;
+        }
+
+        if (victim == recordings.end())
+            break;
+
+        const FunctionRecording *v = victim.value().get();
+        jit_log(LogLevel::Debug,
+                "FrozenFunction::evict(): evicting recording (size=%zu "
+                "bytes, n_replays=%u, priority=%g)", v->size_bytes,
+                v->n_replays, v->priority);
+
+        if (!over_count)
+            evict_clock = std::max(evict_clock, v->priority);
+        total -= v->size_bytes;
+        recordings.erase(victim);
+    }
+}
+
 void FrozenFunction::clear() {
     recordings.clear();
     prev_key          = std::make_shared<FlatVariables>(FlatVariables());
+    last_key.reset();
     recording_counter = 0;
     call_counter      = 0;
+    evict_clock       = 0.0;
 }
 
 /**
@@ -2179,11 +2296,28 @@ void export_freeze(nb::module_ & /*m*/) {
     auto traversable_base =
         nb::class_<drjit::TraversableBase>(d, "TraversableBase");
     nb::class_<FrozenFunction>(d, "FrozenFunction", nb::type_slots(slots))
-        .def(nb::init<nb::callable, int, uint32_t, JitBackend, bool>())
+        .def(nb::init<nb::callable, int, uint32_t, JitBackend, bool,
+                      int64_t>())
         .def_prop_ro(
             "n_cached_recordings",
             [](FrozenFunction &self) { return self.n_cached_recordings(); })
         .def_ro("n_recordings", &FrozenFunction::recording_counter)
+        .def_prop_ro("cache_bytes", &FrozenFunction::cache_bytes)
+        .def("recording_stats",
+             [](FrozenFunction &self) {
+                 nb::list result;
+                 for (auto &it : self.recordings) {
+                     const FunctionRecording &r = *it.second;
+                     nb::dict d;
+                     d["n_replays"]   = r.n_replays;
+                     d["record_time"] = r.record_time;
+                     d["replay_time"] = r.replay_time;
+                     d["size_bytes"]  = r.size_bytes;
+                     d["last_used"]   = r.last_used;
+                     result.append(d);
+                 }
+                 return result;
+             })
         .def("clear", &FrozenFunction::clear)
         .def("__call__", &FrozenFunction::operator());
 }
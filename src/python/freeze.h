@@ -237,6 +237,11 @@ struct FlatVariables {
 
     uint32_t recursion_level = 0;
 
+    /// Memoized result of \ref FlatVariablesHasher, or 0 if not computed yet.
+    /// Keys of the \c RecordingMap are not modified after insertion, which
+    /// avoids re-hashing them on lookups and when the map grows.
+    mutable size_t hash = 0;
+
     struct recursion_guard {
         FlatVariables *flat_variables;
         recursion_guard(FlatVariables *flat_variables)
@@ -289,6 +294,7 @@ struct FlatVariables {
 
     void clear() {
         layout_index = 0;
+        hash = 0;
         variables.clear();
         index_to_slot.clear();
         layout.clear();
@@ -514,9 +520,15 @@ struct FlatVariables {
      */
     void assign_with_registry(nb::handle dst, TraverseContext &ctx);
 
+    /// Estimate the host memory occupied by this object and its layout in bytes
+    size_t memory_usage() const;
+
     bool operator==(const FlatVariables &rhs) const {
-        return this->layout == rhs.layout &&
-               this->var_layout == rhs.var_layout && this->flags == rhs.flags;
+        // Compare the cheap fields first
+        return this->flags == rhs.flags &&
+               this->layout.size() == rhs.layout.size() &&
+               this->var_layout == rhs.var_layout &&
+               this->layout == rhs.layout;
     }
 };
 
@@ -530,7 +542,7 @@ struct FlatVariablesEqual {
     using is_transparent = void;
     bool operator()(const std::shared_ptr<FlatVariables> &lhs,
                     const std::shared_ptr<FlatVariables> &rhs) const {
-        return *lhs.get() == *rhs.get();
+        return lhs.get() == rhs.get() || *lhs.get() == *rhs.get();
     }
 };
 
@@ -553,6 +565,22 @@ struct FunctionRecording {
     /// use in \c record and \c replay.
     FlatVariables out_variables;
 
+    /// Number of times this recording has been replayed
+    uint32_t n_replays = 0;
+
+    /// Total time spent recording and replaying this function (in seconds)
+    double record_time = 0.0, replay_time = 0.0;
+
+    /// Estimated memory footprint of the recording in bytes. This is the
+    /// total size of the output and modified input buffers that each replay
+    /// allocates, plus the host memory of the input and output layouts. The
+    /// memory held by the JIT recording itself (kernels and operation list)
+    /// is not included, as the JIT compiler does not report it.
+    size_t size_bytes = 0;
+
+    /// Eviction priority under a byte budget, see \ref FrozenFunction::evict()
+    double priority = 0.0;
+
     FunctionRecording() : out_variables() {}
     FunctionRecording(const FunctionRecording &)            = delete;
     FunctionRecording &operator=(const FunctionRecording &) = delete;
@@ -573,6 +601,7 @@ struct FunctionRecording {
 
         this->recording     = nullptr;
         this->out_variables = FlatVariables();
+        this->size_bytes    = 0;
     }
 
     /*
@@ -607,6 +636,15 @@ struct FrozenFunction {
     /// opaque masks.
     std::shared_ptr<detail::FlatVariables> prev_key;
 
+    /// The key of the most recently used recording. Frozen functions are
+    /// usually called repeatedly with compatible inputs, and comparing
+    /// against this key avoids hashing the input layout on every call. The
+    /// comparison remains linear in the size of the layout. The inputs are
+    /// still traversed on every call: containers may have been mutated in
+    /// place, so identical Python objects do not imply an identical layout,
+    /// and the current JIT variable indices must be collected in any case.
+    std::shared_ptr<detail::FlatVariables> last_key;
+
     /// This is used by the auto opaque feature to tag variables that should be
     /// made opaque before calling the function.
     drjit::vector<bool> opaque_mask;
@@ -626,6 +664,16 @@ struct FrozenFunction {
     /// without limit.
     int max_cache_size            = -1;
 
+    /// Maximum total \c FunctionRecording::size_bytes of the cached
+    /// recordings. Recordings are evicted based on their size and replay
+    /// frequency once it is exceeded. If this value is -1, the memory is not
+    /// bounded.
+    int64_t max_cache_bytes       = -1;
+
+    /// Priority of the last recording evicted due to \c max_cache_bytes. It
+    /// ages the priorities of recordings that are no longer used.
+    double evict_clock            = 0.0;
+
     /// The number of recordings after which a warning message will be
     /// displayed. This is useful to detect cases in which changing Python
     /// values prevents replay.
@@ -647,8 +695,10 @@ struct FrozenFunction {
     FrozenFunction(nb::callable func, int max_cache_size = -1,
                    uint32_t warn_recording_count = 10,
                    JitBackend backend            = JitBackend::None,
-                   bool auto_opaque              = false)
+                   bool auto_opaque              = false,
+                   int64_t max_cache_bytes       = -1)
         : func(func), max_cache_size(max_cache_size),
+          max_cache_bytes(max_cache_bytes),
           warn_recording_count(warn_recording_count), default_backend(backend),
           auto_opaque(auto_opaque) {}
     ~FrozenFunction() {}
@@ -661,6 +711,26 @@ struct FrozenFunction {
     /// Returns the number of recordings currently cached.
     uint32_t n_cached_recordings() { return (uint32_t) this->recordings.size(); }
 
+    /// Returns the total estimated size of the cached recordings in bytes.
+    size_t cache_bytes() const;
+
+    /**
+     * \brief Evict recordings until at most \c max_count remain, and their
+     * total size is within \c max_cache_bytes.
+     *
+     * The count limit evicts the least recently used recording. The byte
+     * budget uses the GreedyDual-Size-Frequency policy instead: each use of a
+     * recording sets its priority to <tt>evict_clock + (n_replays + 1) /
+     * size_bytes</tt>, and the recording with the lowest priority is evicted
+     * first (ties are broken by recency). Evicting a recording advances \c
+     * evict_clock to its priority, so that frequently replayed recordings
+     * that are no longer used eventually become candidates for eviction.
+     *
+     * The recording \c keep (if specified) is never evicted.
+     */
+    void evict(size_t max_count,
+               const detail::FunctionRecording *keep = nullptr);
+
     /// Clears the frozen function recordings and resets the counters.
     void clear();
 
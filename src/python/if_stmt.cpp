@@ -126,9 +126,11 @@ nb::object if_stmt(nb::tuple args, nb::handle cond, nb::callable true_fn,
             symbolic = 1;
         else if (mode == "evaluated")
             symbolic = 0;
+        else if (mode == "auto")
+            symbolic = 2;
         else
             nb::raise("invalid 'mode' argument (must equal None, "
-                      "\"scalar\", \"symbolic\", or \"evaluated\").");
+                      "\"scalar\", \"symbolic\", \"evaluated\", or \"auto\").");
 
         const char *name_cstr =
             name.has_value() ? name.value().c_str() : "unnamed";
@@ -196,8 +198,26 @@ void export_if_stmt(nb::module_ &m) {
                         "arg_labels: typing.Sequence[str] = (), "
                         "rv_labels: typing.Sequence[str] = (), "
                         "label: str | None = None, "
-                        "mode: typing.Literal['scalar', 'symbolic', 'evaluated', None] = None, "
+                        "mode: typing.Literal['scalar', 'symbolic', 'evaluated', 'auto', None] = None, "
                         "strict: bool = True) "
             "-> T")
     );
+
+    m.def("cond_stats",
+          [](const char *label) -> nb::object {
+              ADCondStats stats;
+              if (!ad_cond_stats(label, &stats))
+                  return nb::none();
+
+              nb::dict dict;
+              dict["calls"] = stats.calls;
+              dict["lanes_true"] = stats.lanes_true;
+              dict["lanes_false"] = stats.lanes_false;
+              dict["skipped"] = stats.skipped;
+              dict["evaluated"] = stats.evaluated;
+              return dict;
+          },
+          "label"_a, doc_cond_stats);
+
+    m.def("cond_stats_clear", &ad_cond_stats_clear, doc_cond_stats_clear);
 }
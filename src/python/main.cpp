@@ -177,6 +177,15 @@ NB_MODULE(_drjit_ext, m_) {
         .value("Clamp", dr::WrapMode::Clamp)
         .value("Mirror", dr::WrapMode::Mirror);
 
+    nb::enum_<dr::TextureLayout>(m, "TextureLayout", doc_TextureLayout)
+        .value("Linear", dr::TextureLayout::Linear, doc_TextureLayout_Linear)
+        .value("Tiled", dr::TextureLayout::Tiled, doc_TextureLayout_Tiled);
+
+    nb::enum_<dr::TextureFormat>(m, "TextureFormat", doc_TextureFormat)
+        .value("Full", dr::TextureFormat::Full, doc_TextureFormat_Full)
+        .value("Quantized8", dr::TextureFormat::Quantized8,
+               doc_TextureFormat_Quantized8);
+
     m.def("has_backend", &jit_has_backend, doc_has_backend);
 
     m.def("sync_thread", &jit_sync_thread, doc_sync_thread, nb::call_guard<nb::gil_scoped_release>())
@@ -238,6 +247,7 @@ NB_MODULE(_drjit_ext, m_) {
     python_cleanup_thread_static_initialization();
     nb::module_::import_("atexit").attr("register")(nb::cpp_function([]() {
         dr::sync_thread(); // Finish any ongoing Dr.Jit computations.
+        ad_cond_stats_clear(); // Release device-side branch statistics.
         python_cleanup_thread_static_shutdown();
     }));
 
@@ -212,6 +212,72 @@ nb::object gather(nb::type_object dtype, nb::object source,
     nb::raise_type_error("drjit.gather(<%s>): unsupported dtype!", nb::type_name(dtype).c_str());
 }
 
+static nb::list gather_footprint(nb::handle_t<ArrayBase> source,
+                                 nb::sequence index, nb::sequence weight,
+                                 size_t size, nb::object active,
+                                 ReduceMode mode) {
+    nb::handle source_tp = source.type();
+    const ArraySupplement &source_supp = supp(source_tp);
+
+    if (source_supp.ndim != 1 || source_supp.shape[0] != DRJIT_DYNAMIC ||
+        (JitBackend) source_supp.backend == JitBackend::None)
+        nb::raise("drjit.gather_footprint(): 'source' argument must be a "
+                  "dynamic 1D JIT array!");
+
+    if (size == 0 || (size & (size - 1)) != 0)
+        nb::raise("drjit.gather_footprint(): 'size' must be a power of two!");
+
+    size_t count = nb::len(index);
+    if (count == 0 || count != nb::len(weight))
+        nb::raise("drjit.gather_footprint(): 'index' and 'weight' must be "
+                  "non-empty sequences of the same length!");
+
+    ArrayMeta active_meta = source_supp,
+              index_meta  = source_supp;
+    active_meta.type = (uint16_t) VarType::Bool;
+    index_meta.type = (uint16_t) VarType::UInt32;
+
+    nb::handle active_tp = meta_get_type(active_meta),
+               index_tp = meta_get_type(index_meta);
+
+    if (!active.type().is(active_tp))
+        active = active_tp(active);
+
+    // Keep the converted arguments alive until the operation has been recorded
+    nb::list index_o, weight_o;
+    uint32_t *offsets = (uint32_t *) alloca(sizeof(uint32_t) * count);
+    uint64_t *weights = (uint64_t *) alloca(sizeof(uint64_t) * count);
+
+    for (size_t k = 0; k < count; ++k) {
+        nb::object i = index[k], w = weight[k];
+        if (!i.type().is(index_tp))
+            i = index_tp(i);
+        if (!w.type().is(source_tp))
+            w = source_tp(w);
+        offsets[k] = (uint32_t) supp(index_tp).index(inst_ptr(i));
+        weights[k] = source_supp.index(inst_ptr(w));
+        index_o.append(i);
+        weight_o.append(w);
+    }
+
+    uint64_t *out_indices = (uint64_t *) alloca(sizeof(uint64_t) * size);
+    ad_var_gather_footprint(size, source_supp.index(inst_ptr(source)), count,
+                            offsets, weights,
+                            (uint32_t) supp(active_tp).index(inst_ptr(active)),
+                            out_indices, mode);
+
+    nb::list result;
+    for (size_t i = 0; i < size; ++i) {
+        nb::object elem = inst_alloc(source_tp);
+        source_supp.init_index(out_indices[i], inst_ptr(elem));
+        nb::inst_mark_ready(elem);
+        ad_var_dec_ref(out_indices[i]);
+        result.append(elem);
+    }
+
+    return result;
+}
+
 static void scatter_generic(const char *name, ReduceOp op, nb::object target,
                             nb::object value, nb::object index,
                             nb::object active, ReduceMode mode) {
@@ -1148,6 +1214,14 @@ void export_memop(nb::module_ &m) {
                              "active: AnyArray | Sequence[bool] | bool = True, "
                              "mode: drjit.ReduceMode = drjit.ReduceMode.Auto, "
                              "shape: tuple[int, ...] | None = None) -> T"))
+     .def("gather_footprint", &gather_footprint, "source"_a, "index"_a,
+          "weight"_a, "size"_a, "active"_a = true,
+          "mode"_a = ReduceMode::Auto, doc_gather_footprint,
+          nb::sig("def gather_footprint(source: ArrayT, "
+                  "index: Sequence[AnyArray], weight: Sequence[AnyArray], "
+                  "size: int, active: AnyArray | bool = True, "
+                  "mode: drjit.ReduceMode = drjit.ReduceMode.Auto) "
+                  "-> list[ArrayT]"))
      .def("scatter", &scatter, "target"_a, "value"_a, "index"_a,
           "active"_a = true, "mode"_a = ReduceMode::Auto,
           doc_scatter)
@@ -11,10 +11,35 @@
 #include <drjit/resample.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/optional.h>
+#include <nanobind/stl/vector.h>
 #include "common.h"
 
+/// Bind the fused multi-axis resampling routine for the array type 'T'
+template <typename T> static void bind_resample_fused(nb::module_ &detail) {
+    using dr::Resampler;
+
+    // Convert a list of (optional) resamplers into a pointer array
+    auto convert = [](nb::list resamplers, const std::vector<uint32_t> &shape) {
+        if (resamplers.size() != shape.size())
+            nb::raise("drjit.detail.resample_fused_fwd(): 'resamplers' and "
+                      "'shape' must have the same size.");
+        std::vector<const Resampler *> result;
+        result.reserve(shape.size());
+        for (nb::handle h : resamplers)
+            result.push_back(h.is_none() ? nullptr : nb::cast<const Resampler *>(h));
+        return result;
+    };
+
+    detail.def("resample_fused_fwd",
+        [convert](const T &source, nb::list resamplers, const std::vector<uint32_t> &shape) {
+            std::vector<const Resampler *> r = convert(resamplers, shape);
+            return Resampler::resample_fwd_fused(source, r.data(), shape.data(),
+                                                 (uint32_t) shape.size());
+        }, "source"_a.noconvert(), "resamplers"_a, "shape"_a);
+}
+
 void export_resample(nb::module_ &) {
-    nb::object detail = nb::module_::import_("drjit").attr("detail");
+    nb::module_ detail = nb::module_::import_("drjit.detail");
     using dr::Resampler;
 
     auto resampler = nb::class_<Resampler>(detail, "Resampler")
@@ -83,6 +108,7 @@ void export_resample(nb::module_ &) {
               "source"_a.noconvert(), "stride"_a)
          .def_prop_ro("source_res", &Resampler::source_res)
          .def_prop_ro("target_res", &Resampler::target_res)
+         .def_prop_ro("taps", &Resampler::taps)
          .def("__repr__",
               [](const Resampler &r) {
                   return "Resampler[source_res="
@@ -91,5 +117,19 @@ void export_resample(nb::module_ &) {
                     + ", taps=" + std::to_string(r.taps())
                     + "]";
               });
+
+#if defined(DRJIT_ENABLE_CUDA)
+    bind_resample_fused<dr::CUDAArray<dr::half>>(detail);
+    bind_resample_fused<dr::CUDAArray<float>>(detail);
+    bind_resample_fused<dr::CUDAArray<double>>(detail);
+#endif
+#if defined(DRJIT_ENABLE_LLVM)
+    bind_resample_fused<dr::LLVMArray<dr::half>>(detail);
+    bind_resample_fused<dr::LLVMArray<float>>(detail);
+    bind_resample_fused<dr::LLVMArray<double>>(detail);
+#endif
+    bind_resample_fused<dr::DynamicArray<dr::half>>(detail);
+    bind_resample_fused<dr::DynamicArray<float>>(detail);
+    bind_resample_fused<dr::DynamicArray<double>>(detail);
 }
 
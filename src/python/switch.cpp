@@ -66,8 +66,10 @@ static int extract_mode(nb::kwargs &kwargs) {
         return 1;
     else if (strcmp(mode_str, "evaluated") == 0)
         return 0;
+    else if (strcmp(mode_str, "adaptive") == 0)
+        return 2;
     else
-        nb::raise("'mode' must equal None, 'symbolic', or 'evaluated'");
+        nb::raise("'mode' must equal None, 'symbolic', 'evaluated', or 'adaptive'");
 }
 
 static dr::string extract_label(nb::kwargs &kwargs, const char *def) {
@@ -86,6 +88,160 @@ static dr::string extract_label(nb::kwargs &kwargs, const char *def) {
     return def;
 }
 
+/// Extract the optional 'coherence' key used to reorder threads in evaluated mode
+static nb::object extract_coherence(nb::kwargs &kwargs) {
+    nb::str coherence_key("coherence");
+    if (!kwargs.contains(coherence_key))
+        return nb::object();
+
+    nb::object coherence = kwargs[coherence_key];
+    nb::del(kwargs[coherence_key]);
+
+    if (coherence.is_none())
+        return nb::object();
+
+    nb::handle tp = coherence.type();
+    if (!is_drjit_type(tp))
+        nb::raise("'coherence' must be None or a Dr.Jit array!");
+
+    const ArraySupplement &s = supp(tp);
+    if ((JitBackend) s.backend == JitBackend::None ||
+        (VarType) s.type != VarType::UInt32 || s.ndim != 1)
+        nb::raise("'coherence' must be None or a Jit-compiled 1D 32-bit "
+                  "unsigned integer array!");
+
+    return coherence;
+}
+
+/**
+ * \brief Flatten nested switch statements into a single one
+ *
+ * ``index`` is a sequence of per-level indices, and ``targets`` a
+ * correspondingly nested sequence of callables (e.g., materials containing
+ * BSDF lobes). The function numbers the leaves of this tree from left to right
+ * and computes the flat callable index of each lane by walking the tree one
+ * level at a time via a table of child offsets. The resulting single switch
+ * statement needs only one reduction in evaluated mode.
+ *
+ * Each per-level index is checked against the number of children of its node.
+ * Scalar indices that are out of bounds raise an exception, while array
+ * entries that are out of bounds at any level are mapped to the index
+ * ``0xFFFFFFFF``, which disables the corresponding lanes of the call.
+ */
+static std::pair<nb::object, nb::list>
+switch_flatten(nb::sequence index, nb::sequence targets, nb::handle mask) {
+    size_t depth = nb::len(index);
+    if (depth == 0)
+        nb::raise("the 'index' sequence cannot be empty");
+
+    // Child offset and child count tables of all levels except for the last one
+    dr::vector<nb::list> offsets, counts;
+    nb::list nodes;
+    for (nb::handle h : targets)
+        nodes.append(h);
+    size_t root_count = nb::len(nodes);
+
+    for (size_t l = 1; l < depth; ++l) {
+        nb::list next, offset, count;
+        for (nb::handle node : nodes) {
+            if (!nb::isinstance<nb::sequence>(node) || nb::isinstance<nb::str>(node))
+                nb::raise("'targets' must be nested %zu levels deep to match "
+                          "the 'index' sequence", depth);
+            size_t start = nb::len(next);
+            offset.append(start);
+            for (nb::handle h : nb::borrow<nb::sequence>(node))
+                next.append(h);
+            count.append(nb::len(next) - start);
+        }
+        offsets.push_back(std::move(offset));
+        counts.push_back(std::move(count));
+        nodes = std::move(next);
+    }
+
+    // Find the array type used by the per-level indices (if any)
+    nb::handle index_tp;
+    for (nb::handle h : index) {
+        if (is_drjit_type(h.type())) {
+            index_tp = h.type();
+            break;
+        }
+    }
+
+    nb::object result = index[0];
+    if (!index_tp.is_valid()) {
+        // Scalar case, walk the tree directly
+        size_t node = 0, count = root_count;
+        for (size_t l = 0; l < depth; ++l) {
+            size_t index_l = nb::cast<size_t>(index[l]);
+            if (index_l >= count)
+                nb::raise("Attempted to invoke callable with index %zu at "
+                          "level %zu, but this value must be smaller than %zu.",
+                          index_l, l, count);
+            node += index_l;
+            if (l + 1 < depth) {
+                count = nb::cast<size_t>(counts[l][node]);
+                node = nb::cast<size_t>(offsets[l][node]);
+            }
+        }
+        return { nb::int_(node), nodes };
+    }
+
+    nb::object gather = array_module.attr("gather"),
+               select = array_module.attr("select");
+    result = index_tp(result);
+
+    // Lanes with an out-of-bounds index at any level are disabled below
+    nb::object valid = result.attr("__lt__")(nb::int_(root_count));
+    if (mask.is_valid())
+        valid = valid & mask;
+
+    for (size_t l = 1; l < depth; ++l) {
+        nb::object table = index_tp(offsets[l - 1]),
+                   count = index_tp(counts[l - 1]),
+                   index_l = index_tp(index[l]);
+        nb::object start = gather(index_tp, table, result, valid);
+        valid = valid & index_l.attr("__lt__")(gather(index_tp, count, result, valid));
+        result = start + index_l;
+    }
+
+    result = select(valid, result, index_tp(0xFFFFFFFFu));
+    return { result, nodes };
+}
+
+/**
+ * \brief Identify the set of callables of a switch statement
+ *
+ * Adaptive mode caches its decision per call site. Unlabeled switch statements
+ * share the same name, hence this function combines the identities of the
+ * callables into an identifier. Functions are identified by their code
+ * object, which remains the same when lambda functions are re-created on every
+ * call. Bound methods additionally include their instance, and other callable
+ * objects are identified by the instance itself, since different instances of
+ * a callable class may perform different amounts of work.
+ */
+static uint64_t switch_site(nb::sequence targets) {
+    nb::str code_key("__code__"), func_key("__func__"), self_key("__self__");
+    uint64_t site = 0;
+    auto combine = [&](nb::handle h) {
+        site = (site ^ (uint64_t) (uintptr_t) h.ptr()) * 0x100000001b3ull;
+    };
+    for (nb::handle h : targets) {
+        if (nb::hasattr(h, code_key)) {
+            combine(nb::object(h.attr(code_key)));
+        } else if (nb::hasattr(h, func_key) && nb::hasattr(h, self_key)) {
+            nb::object func = h.attr(func_key);
+            if (nb::hasattr(func, code_key))
+                combine(nb::object(func.attr(code_key)));
+            else
+                combine(func);
+            combine(nb::object(h.attr(self_key)));
+        } else {
+            combine(h);
+        }
+    }
+    return site;
+}
+
 nb::object switch_impl(nb::handle index_, nb::sequence targets,
                        nb::args args_, nb::kwargs kwargs) {
     struct State {
@@ -99,6 +255,20 @@ nb::object switch_impl(nb::handle index_, nb::sequence targets,
         nb::object mask = extract_mask(args, kwargs);
         int symbolic = extract_mode(kwargs);
         dr::string label = extract_label(kwargs, "drjit.switch()");
+        nb::object coherence = extract_coherence(kwargs);
+
+        // Flatten nested switch statements given a sequence of indices
+        nb::object index_flat;
+        if (nb::isinstance<nb::tuple>(index_) || nb::isinstance<nb::list>(index_)) {
+            nb::handle mask_h;
+            if (mask.is_valid() && is_drjit_type(mask.type()))
+                mask_h = mask;
+            auto [index_o, targets_o] = switch_flatten(
+                nb::borrow<nb::sequence>(index_), targets, mask_h);
+            index_flat = std::move(index_o);
+            index_ = index_flat;
+            targets = nb::borrow<nb::sequence>(targets_o);
+        }
 
         nb::handle index_tp = index_.type();
         if (index_tp.is(&PyLong_Type)) {
@@ -170,7 +340,11 @@ nb::object switch_impl(nb::handle index_, nb::sequence targets,
             symbolic, nb::len(targets), label.c_str(), false,
             (uint32_t) s.index(inst_ptr(index)),
             mask.is_valid() ? ((uint32_t) s.index(inst_ptr(mask))) : 0u, args_i,
-            rv_i, state, func, cleanup, true);
+            rv_i, state, func, cleanup, true,
+            coherence.is_valid()
+                ? (uint32_t) supp(coherence.type()).index(inst_ptr(coherence))
+                : 0u,
+            symbolic == 2 ? switch_site(targets) : 0);
 
         nb::object result = ::update_indices(state->rv_o, rv_i);
 
@@ -230,6 +404,7 @@ nb::object dispatch_impl(nb::handle_t<dr::ArrayBase> inst,
         nb::object mask = extract_mask(args, kwargs);
         int symbolic = extract_mode(kwargs);
         dr::string label = extract_label(kwargs, "drjit.dispatch()");
+        nb::object coherence = extract_coherence(kwargs);
 
         ad_call_func target_cb = [](void *ptr, void *self,
                                     const dr::vector<uint64_t> &args_i,
@@ -288,7 +463,10 @@ nb::object dispatch_impl(nb::handle_t<dr::ArrayBase> inst,
                     state->domain_name.c_str(), symbolic, 0, label.c_str(),
                     false, (uint32_t) s.index(inst_ptr(inst)),
                     mask.is_valid() ? ((uint32_t) s.index(inst_ptr(mask))) : 0u,
-                    args_i, rv_i, state, target_cb, cleanup, true);
+                    args_i, rv_i, state, target_cb, cleanup, true,
+                    coherence.is_valid()
+                        ? (uint32_t) supp(coherence.type()).index(inst_ptr(coherence))
+                        : 0u);
 
         nb::object result = ::update_indices(state->rv_o, rv_i);
 
@@ -37,6 +37,13 @@ void bind_texture(nb::module_ &m, const char *name) {
         .def("wrap_mode", &Tex::wrap_mode, doc_Texture_wrap_mode)
         .def("use_accel", &Tex::use_accel, doc_Texture_use_accel)
         .def("migrated", &Tex::migrated, doc_Texture_migrated)
+        .def("layout", &Tex::layout, doc_Texture_layout)
+        .def("set_layout", &Tex::set_layout, "layout"_a, doc_Texture_set_layout)
+        .def("format", &Tex::format, doc_Texture_format)
+        .def("set_format", &Tex::set_format, "format"_a, doc_Texture_set_format)
+        .def("build_mipmaps", &Tex::build_mipmaps, "levels"_a = 0,
+             doc_Texture_build_mipmaps)
+        .def("mipmap_levels", &Tex::mipmap_levels, doc_Texture_mipmap_levels)
         .def_prop_ro("shape", [](const Tex &t) {
             PyObject *shape = PyTuple_New(t.ndim());
             for (size_t i = 0; i < t.ndim(); ++i)
@@ -62,6 +69,49 @@ void bind_texture(nb::module_ &m, const char *name) {
         .def_tex_eval(Float16)
         .def_tex_eval(Float64)
         #undef def_tex_eval
+        #define def_tex_eval_lod(T)                                           \
+            def("eval_lod",                                                    \
+                [](const Tex &texture, const dr::Array<T, Dimension> &pos,     \
+                   const T &lod, const std::optional<dr::mask_t<T>> active_) { \
+                    dr::mask_t<T> active = active_.has_value() ?               \
+                                                     active_.value() :         \
+                                                     true;                     \
+                                                                               \
+                    size_t channels = texture.shape()[Dimension];              \
+                    dr::vector<T> result(channels);                            \
+                    texture.eval_lod(pos, lod, result.data(), active);         \
+                                                                               \
+                    return result;                                             \
+                }, "pos"_a, "lod"_a, "active"_a.sig("Bool(True)") = nb::none(),\
+                doc_Texture_eval_lod)
+        .def_tex_eval_lod(Float32)
+        .def_tex_eval_lod(Float16)
+        .def_tex_eval_lod(Float64)
+        #undef def_tex_eval_lod
+        #define def_tex_eval_footprint(T)                                     \
+            def("eval_footprint",                                              \
+                [](const Tex &texture, const dr::Array<T, Dimension> &pos,     \
+                   const dr::Array<T, Dimension> &dp_dx,                       \
+                   const dr::Array<T, Dimension> &dp_dy,                       \
+                   const std::optional<dr::mask_t<T>> active_,                 \
+                   uint32_t max_anisotropy) {                                  \
+                    dr::mask_t<T> active = active_.has_value() ?               \
+                                                     active_.value() :         \
+                                                     true;                     \
+                                                                               \
+                    size_t channels = texture.shape()[Dimension];              \
+                    dr::vector<T> result(channels);                            \
+                    texture.eval_footprint(pos, dp_dx, dp_dy, result.data(),   \
+                                           active, max_anisotropy);            \
+                                                                               \
+                    return result;                                             \
+                }, "pos"_a, "dp_dx"_a, "dp_dy"_a,                              \
+                "active"_a.sig("Bool(True)") = nb::none(),                     \
+                "max_anisotropy"_a = 1, doc_Texture_eval_footprint)
+        .def_tex_eval_footprint(Float32)
+        .def_tex_eval_footprint(Float16)
+        .def_tex_eval_footprint(Float64)
+        #undef def_tex_eval_footprint
         #define def_tex_eval_fetch(T)                                          \
             def("eval_fetch",                                                  \
                 [](const Tex &texture, const dr::Array<T, Dimension> &pos,     \
@@ -234,4 +234,40 @@ void export_while_loop(nb::module_ &m) {
                            "max_iterations: int | None = None) "
             "-> tuple[*Ts]"
     ));
+
+    nb::enum_<ADCompressPolicy>(m, "CompressPolicy", doc_CompressPolicy)
+        .value("Always", ADCompressPolicy::Always, doc_CompressPolicy_Always)
+        .value("Threshold", ADCompressPolicy::Threshold, doc_CompressPolicy_Threshold)
+        .value("Interval", ADCompressPolicy::Interval, doc_CompressPolicy_Interval)
+        .value("CostModel", ADCompressPolicy::CostModel, doc_CompressPolicy_CostModel);
+
+    m.def("set_compress_policy",
+          [](const char *label, ADCompressPolicy policy, double param) {
+              ad_loop_set_compress_policy(label, policy, param);
+          },
+          "label"_a, "policy"_a, "param"_a = 0.0, doc_set_compress_policy);
+
+    m.def("set_persistent_iterations", &ad_loop_set_persistent_iterations,
+          "label"_a, "iterations"_a, doc_set_persistent_iterations);
+
+    m.def("loop_stats",
+          [](const char *label) -> nb::object {
+              ADLoopStats stats;
+              if (!ad_loop_stats(label, &stats))
+                  return nb::none();
+
+              nb::list active_fraction;
+              for (float f : stats.active_fraction)
+                  active_fraction.append(f);
+
+              nb::dict dict;
+              dict["iterations"] = stats.iterations;
+              dict["compressions"] = stats.compressions;
+              dict["bytes_moved"] = stats.bytes_moved;
+              dict["active_fraction"] = active_fraction;
+              return dict;
+          },
+          "label"_a, doc_loop_stats);
+
+    m.def("loop_stats_clear", &ad_loop_stats_clear, doc_loop_stats_clear);
 }
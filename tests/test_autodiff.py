@@ -2159,3 +2159,131 @@ def test137_forward_from_existing_gradient(t):
     a.grad = 1000
     dr.forward_from(a)
     assert dr.allclose(b.grad, 2000)
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test138_multithreaded_tracing(t):
+    # Several threads trace independent graphs that all reference a shared
+    # input. This checks the correctness of concurrent reference counting
+    # and graph updates; it does not measure scaling.
+    from concurrent.futures import ThreadPoolExecutor
+
+    x = t(1, 2, 3)
+    dr.enable_grad(x)
+
+    def trace(i):
+        y = t(i, i, i)
+        dr.enable_grad(y)
+        z = x
+        for _ in range(100):
+            z = z * y + x
+        dr.backward_from(z)
+        return y.grad
+
+    with ThreadPoolExecutor(max_workers=8) as pool:
+        grads = list(pool.map(trace, [1] * 16))
+
+    # z_k = (k+1) * x at y = 1, hence dz_100/dy = x * (1 + 2 + ... + 100)
+    for g in grads:
+        assert dr.allclose(g, t(1, 2, 3) * 5050)
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test139_deep_and_wide_graph(t):
+    # Long dependency chains with many side branches must be traversable
+    # in both directions (the graph search does not recurse)
+    n = 20000
+
+    def build(x):
+        y = x
+        for i in range(n):
+            y = y + x * 0.5
+        return y
+
+    x = t(1, 2)
+    dr.enable_grad(x)
+    y = build(x)
+    dr.backward_from(y)
+    assert dr.allclose(x.grad, 1 + 0.5 * n)
+
+    x = t(1, 2)
+    dr.enable_grad(x)
+    y = build(x)
+    dr.forward_from(x)
+    assert dr.allclose(y.grad, 1 + 0.5 * n)
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test140_checkpoint(t):
+    def f(x, scale):
+        for _ in range(10):
+            x = dr.sin(x) * scale['y']
+        return x
+
+    g = dr.checkpoint(f)
+
+    for mode in ('fwd', 'bwd'):
+        grads = []
+        for func in (f, g):
+            x, y = t(1, 2, 3), t(0.5, 1, 1.5)
+            dr.enable_grad(x, y)
+            z = func(x, scale={'y': y})
+            if mode == 'fwd':
+                dr.set_grad(x, 1)
+                dr.set_grad(y, 2)
+                grads.append(dr.forward_to(z))
+            else:
+                dr.backward_from(z)
+                grads.append((x.grad, y.grad))
+        assert dr.allclose(grads[0], grads[1])
+
+    # Small inputs run without checkpointing when a size threshold is given
+    h = dr.checkpoint(f, min_bytes=1024)
+    grads = []
+    for func in (f, h):
+        x = t(1, 2, 3)
+        dr.enable_grad(x)
+        dr.backward_from(func(x, scale={'y': t(2)}))
+        grads.append(x.grad)
+    assert dr.allclose(grads[0], grads[1])
+
+    # With a budget, calls are checkpointed once the AD graph would exceed it
+    calls = []
+
+    def f2(x):
+        calls.append(1)
+        return f(x, scale={'y': t(2)})
+
+    grads = []
+    for checkpointed in (False, True):
+        func = f2
+        if checkpointed:
+            func = dr.checkpoint(f2, budget=dr.detail.ad_graph_bytes())
+        calls.clear()
+        x = t(1, 2, 3)
+        dr.enable_grad(x)
+        y0 = func(x)  # Fits within the budget: runs normally
+        y1 = func(x)  # Would exceed the budget: checkpointed
+        dr.backward_from(y0 + y1)
+        grads.append(x.grad)
+    assert len(calls) == 3
+    assert dr.allclose(grads[0], grads[1])
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test141_release_long_chain(t):
+    # Releasing a long chain frees variables and edges recursively, which
+    # triggers compactions of the free lists in the middle of the traversal.
+    # Subsequent allocations must hand out valid and distinct indices.
+    for _ in range(3):
+        x = t(1, 2)
+        dr.enable_grad(x)
+        y = x
+        for _ in range(5000):
+            y = y * 1.0001
+        del y
+
+        ys = [x * (i + 1) for i in range(5000)]
+        dr.backward_from(ys[-1])
+        assert dr.allclose(x.grad, 5000)
+        assert len(set(v.index_ad for v in ys)) == 5000
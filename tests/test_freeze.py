@@ -3840,3 +3840,72 @@ def test102_assignment(t, auto_opaque):
         func(res)
 
         assert dr.allclose(ref, res)
+
+
+@pytest.test_arrays("float32, jit, shape=(*)")
+def test103_limit_bytes(t):
+    """
+    Tests that recordings are evicted once their estimated size exceeds the
+    ``limit_bytes`` budget, and that per-recording statistics are tracked.
+    """
+
+    def func(x, p):
+        return x + p
+
+    # Each recording produces a single output of 1000 floats, plus a small
+    # amount of host memory for its layouts
+    frozen = dr.freeze(func, limit_bytes=12000)
+
+    x = dr.arange(t, 1000)
+    for p in range(3):
+        assert dr.allclose(frozen(x, p), func(x, p))
+
+    assert frozen.n_recordings == 3
+    assert frozen.n_cached_recordings == 2
+    assert 8000 < frozen.cache_bytes <= 12000
+
+    # p = 2 is still cached and gets replayed
+    frozen(x, 2)
+    frozen(x, 2)
+    assert frozen.n_recordings == 3
+
+    stats = sorted(frozen.recording_stats(), key=lambda s: s["last_used"])
+    assert [s["n_replays"] for s in stats] == [0, 2]
+    assert all(4000 < s["size_bytes"] <= 6000 for s in stats)
+    assert frozen.cache_bytes == sum(s["size_bytes"] for s in stats)
+    assert stats[1]["replay_time"] > 0
+
+    # p = 0 was evicted
+    frozen(x, 0)
+    assert frozen.n_recordings == 4
+
+    # p = 2 was replayed more often and survives, although p = 0 was used
+    # more recently (a LRU policy would evict p = 2 here)
+    frozen(x, 1)
+    assert frozen.n_recordings == 5
+    frozen(x, 2)
+    assert frozen.n_recordings == 5
+
+
+@pytest.test_arrays("float32, jit, shape=(*)")
+@pytest.mark.parametrize("auto_opaque", [False, True])
+def test104_alternating_layouts(t, auto_opaque):
+    """
+    Tests that alternating between input layouts replays the matching
+    recording, including when the previous call used a different one.
+    """
+
+    def func(x, p):
+        return {"a": x + p[0], "b": p[1]}
+
+    frozen = dr.freeze(func, auto_opaque=auto_opaque)
+
+    for i in range(4):
+        x = dr.arange(t, 3 + i)
+        for p in ((1, "u"), (2, "v"), (2, "v")):
+            res = frozen(x, p)
+            ref = func(x, p)
+            assert dr.allclose(res["a"], ref["a"])
+            assert res["b"] == ref["b"]
+
+    assert frozen.n_recordings == 2
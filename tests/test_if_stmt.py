@@ -639,3 +639,63 @@ def test19_tensor_cond(t, mode, variant):
         assert dr.all(z == t([5, 6, 7, 8, 9, 0, 0]))
     else:
         assert dr.all(z == t([1, 1, 1, 1, 1, 0, 0]))
+
+
+# Auto mode records branch statistics and skips branches without active lanes
+@pytest.test_arrays('uint32,is_jit,shape=(*)')
+def test20_if_stmt_auto(t):
+    dr.cond_stats_clear()
+    calls = []
+
+    def true_fn(x):
+        calls.append(True)
+        return x + 1
+
+    def false_fn(x):
+        calls.append(False)
+        return x - 1
+
+    x = dr.arange(t, 10000)
+    for cond, n_calls in ((x < 10, 2), (x < 20000, 1), (x < 5000, 2)):
+        calls.clear()
+        y = dr.if_stmt(
+            args=(x,),
+            cond=cond,
+            true_fn=true_fn,
+            false_fn=false_fn,
+            mode='auto',
+            label='test20'
+        )
+        assert dr.all(y == dr.select(cond, x + 1, x - 1))
+        assert len(calls) == n_calls
+
+    stats = dr.cond_stats('test20')
+    assert stats['calls'] == 3
+    assert stats['lanes_true'] == 10 + 10000 + 5000
+    assert stats['lanes_false'] == 9990 + 5000
+    assert stats['skipped'] == 1
+    assert stats['evaluated'] == 1
+
+    dr.cond_stats_clear()
+    assert dr.cond_stats('test20') is None
+
+    # Other modes also record statistics. The lanes are counted on the device.
+    for mode in ('symbolic', 'evaluated'):
+        cond = x < 10
+        y = dr.if_stmt(
+            args=(x,),
+            cond=cond,
+            true_fn=true_fn,
+            false_fn=false_fn,
+            mode=mode,
+            label='test20'
+        )
+        assert dr.all(y == dr.select(cond, x + 1, x - 1))
+
+    stats = dr.cond_stats('test20')
+    assert stats['calls'] == 2
+    assert stats['lanes_true'] == 2 * 10
+    assert stats['lanes_false'] == 2 * 9990
+    assert stats['skipped'] == 0
+    assert stats['evaluated'] == 1
+    dr.cond_stats_clear()
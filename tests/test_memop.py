@@ -1139,3 +1139,39 @@ def test36_gather_packet(t, packet_size, force_optix):
 
         assert len(re.findall(f"call fastcc \\[.*\\] @gather_{n_regs}x{type_str}", ir)) == n_inst
 
+
+@pytest.mark.parametrize("packet_size", [1, 2, 4])
+@pytest.test_arrays("is_jit, float32, diff, shape=(*)")
+def test37_gather_footprint(t, packet_size):
+    UInt32 = dr.uint32_array_t(t)
+
+    def run(fused):
+        rng = dr.rng(seed=0)
+        source = rng.random(t, 8 * packet_size)
+        weight = [rng.random(t, 10) for _ in range(3)]
+        index = [UInt32(rng.random(t, 10) * 8) for _ in range(3)]
+        active = UInt32(dr.arange(t, 10)) != 3
+        dr.enable_grad(source, weight)
+
+        if fused:
+            out = dr.gather_footprint(source, index, weight, packet_size, active)
+        else:
+            out = [dr.zeros(t, 10) for _ in range(packet_size)]
+            for i, w in zip(index, weight):
+                for k in range(packet_size):
+                    out[k] += w * dr.gather(t, source, i * packet_size + k, active)
+
+        loss = dr.zeros(t, 10)
+        for k in range(packet_size):
+            loss += out[k] * (k + 1)
+        dr.backward(dr.sum(loss))
+        return out, dr.grad(source), [dr.grad(w) for w in weight]
+
+    out_1, dsource_1, dweight_1 = run(True)
+    out_2, dsource_2, dweight_2 = run(False)
+
+    for a, b in zip(out_1, out_2):
+        assert dr.allclose(a, b)
+    assert dr.allclose(dsource_1, dsource_2)
+    for a, b in zip(dweight_1, dweight_2):
+        assert dr.allclose(a, b)
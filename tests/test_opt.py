@@ -345,3 +345,84 @@ def test10_promote_fp16(optimizer_class, promote_fp16, t):
     if not success:
         print(f"  Target: {target}, Final: {final_value[0]:.8f}")
     assert success
+
+
+@pytest.mark.parametrize("optimizer_class", [SGD, RMSProp, Adam])
+@pytest.test_arrays("is_diff,float32,shape=(*)")
+def test11_grad_blocks(optimizer_class, t):
+    # Only blocks touched by gathers should be updated
+    UInt32 = dr.uint32_array_t(t)
+    opt = optimizer_class(lr=1e-1, grad_block_size=4)
+    opt["x"] = dr.zeros(t, 18)
+
+    y = dr.gather(t, opt["x"], UInt32(5, 17))
+    dr.backward(dr.sum(1 - y))
+    del y
+
+    # Blocks are marked during the reverse-mode traversal
+    assert dr.all(dr.grad_blocks(opt["x"]) == [False, True, False, False, True])
+    index = opt.state["x"][0].index
+    opt.step()
+
+    # The touched blocks are written back in place
+    assert opt.state["x"][0].index == index
+
+    x = opt["x"].numpy()
+    assert (x[4:8] != 0).sum() == 1 and x[5] > 0
+    assert x[17] > 0
+    assert (x[:4] == 0).all() and (x[8:16] == 0).all()
+
+    # Tracking is re-enabled for the updated parameter
+    assert not dr.any(dr.grad_blocks(opt["x"]))
+
+
+@pytest.test_arrays("is_diff,float32,shape=(*)")
+def test12_adam_lazy(t):
+    # Lazy Adam tracks the iteration count per entry, which keeps the
+    # first update of an entry exact regardless of when it occurs
+    UInt32 = dr.uint32_array_t(t)
+    opt = Adam(lr=1e-1, lazy=True)
+    opt["x"] = dr.zeros(t, 8)
+
+    for i in (1, 2):
+        y = dr.gather(t, opt["x"], UInt32(i))
+        dr.backward(dr.sum(1 - y))
+        del y
+
+        # The parameter and the per-entry state are updated in place
+        state = opt.state["x"]
+        indices = [state[0].index] + [v.index for v in state[3]]
+        del state
+        opt.step()
+        state = opt.state["x"]
+        assert [state[0].index] + [v.index for v in state[3]] == indices
+        del state
+
+    x = opt["x"].numpy()
+    assert dr.allclose(x[1], 0.1) and dr.allclose(x[2], 0.1)
+    assert (x[[0, 3, 4, 5, 6, 7]] == 0).all()
+    assert dr.all(opt.state["x"][3][0] == UInt32(0, 1, 1, 0, 0, 0, 0, 0))
+
+
+@pytest.test_arrays("is_diff,float32,shape=(*)")
+def test13_master_weights(t):
+    # Promoted parameters expose an evaluated FP16 copy, whose gradients
+    # accumulate in the FP32 master weight
+    t16 = dr.float16_array_t(t)
+    opt = Adam(lr=1e-2, grad_scaler=GradScaler())
+    opt["x"] = t16(1, 2)
+
+    for it in range(5):
+        x = opt["x"]
+        assert type(x) is t16
+        if it > 0:
+            assert x.state == dr.VarState.Evaluated
+
+        # Two backward passes (e.g., gradient accumulation)
+        for _ in range(2):
+            loss = opt.grad_scaler.scale(dr.sum(dr.square(opt["x"] - 3)))
+            dr.backward(loss)
+        assert type(opt.state["x"][0].grad) is t
+        opt.step()
+
+    assert dr.all(opt["x"] > t16(1, 2))
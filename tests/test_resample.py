@@ -1,5 +1,6 @@
 import drjit as dr
 import pytest
+import math
 
 # Test simple upsampling with a box filter (1D array)
 @pytest.test_arrays('float, -jit, shape=(*)')
@@ -113,3 +114,66 @@ def test07_convolve(t):
     y = dr.convolve(x, 'linear', 2)
     z = t((1+2*.5)/1.5, (1*.5+2+10*.5)/2, (2*.5+10+100*.5)/2, (100+10*.5)/1.5)
     assert dr.allclose(y, z)
+
+# Fused multi-axis resampling should match a sequence of 1D resampling steps
+@pytest.mark.parametrize('filter', ['box', 'linear', 'cubic'])
+@pytest.test_arrays('float32, is_diff, tensor, jit')
+def test08_fused(t, filter):
+    x = dr.linspace(dr.array_t(t), 0, 1, 5*7*3)
+    x = t(x * x, (5, 7, 3))
+
+    def run():
+        xc = t(x)
+        dr.enable_grad(xc)
+        y = dr.resample(xc, (11, 4, 3), filter=filter)
+        dr.backward_from(y * y)
+        return y, xc.grad
+
+    y0, g0 = run()
+    max_taps = dr._resample_fused_max_taps
+    try:
+        dr._resample_fused_max_taps = 0
+        y1, g1 = run()
+    finally:
+        dr._resample_fused_max_taps = max_taps
+
+    assert y0.shape == y1.shape
+    assert dr.allclose(y0, y1)
+    assert dr.allclose(g0, g1)
+
+
+# Taps with a zero weight must not propagate non-finite inputs
+@pytest.test_arrays('float, -jit, shape=(*)')
+def test09_nonfinite(t):
+    inf, nan = float('inf'), float('nan')
+    r = dr.resample(t(1, 2, inf, nan, 100, 101), (3,), filter='box')
+    assert r[0] == 1.5 and r[2] == 100.5
+    assert dr.isnan(r[1])
+
+
+# The fused CPU implementation should match a sequence of 1D resampling steps
+@pytest.mark.parametrize('filter', ['box', 'linear', 'cubic', 'lanczos'])
+@pytest.mark.parametrize('shapes', [((9, 13, 3), (20, 5, 3)),
+                                    ((64, 96, 3), (50, 130, 3)),
+                                    ((4, 17, 19), (4, 8, 40))])
+@pytest.test_arrays('float32, -jit, tensor')
+def test10_fused_cpu(t, filter, shapes):
+    source_shape, target_shape = shapes
+    x = dr.linspace(dr.array_t(t), 0, 1, math.prod(source_shape))
+    x = x * x
+
+    resamplers = [
+        dr.detail.Resampler(s, d, filter) if s != d else None
+        for s, d in zip(source_shape, target_shape)
+    ]
+    y0 = dr.detail.resample_fused_fwd(x, resamplers, list(source_shape))
+
+    y1, shape = x, list(source_shape)
+    for i in reversed(range(len(shape))):
+        if resamplers[i] is None:
+            continue
+        shape[i] = target_shape[i]
+        y1 = resamplers[i].resample_fwd(y1, math.prod(shape[i+1:]))
+
+    assert dr.width(y0) == math.prod(target_shape)
+    assert dr.allclose(y0, y1)
@@ -718,3 +718,108 @@ def test18_apply_loop_mask(t, capsys, symbolic_config):
                 assert dr.allclose(out.grad[1], 0)
                 transcript = capsys.readouterr().err
                 assert "Attempted to invoke callable with index 123, but this value must be strictly smaller than 2" not in transcript
+
+# Adaptive mode: coherent indices use symbolic mode, divergent ones evaluated mode
+@pytest.test_arrays('float32,shape=(*),jit')
+def test19_switch_adaptive(t, capsys):
+    UInt32 = dr.uint32_array_t(t)
+    n = 1 << 16
+    c = [lambda x: x + 1, lambda x: x * 2, lambda x: x - 3, lambda x: -x]
+
+    x = dr.arange(t, n)
+    i = dr.arange(UInt32, n)
+
+    level = dr.log_level()
+    dr.set_log_level(dr.LogLevel.Debug)
+    try:
+        for label, index, mode in (('coherent', i // (n // 4), 'symbolic'),
+                                   ('divergent', i % 4, 'evaluated')):
+            result = dr.switch(index, c, x, mode='adaptive', label=label)
+            ref = dr.switch(index, c, x, mode='evaluated')
+            assert dr.all(result == ref)
+
+            transcript = capsys.readouterr()
+            assert f'-> {mode} mode' in transcript.out + transcript.err
+
+        # Unlabeled switch statements with different callables decide separately
+        c2 = [lambda x: x + 2, lambda x: x * 3]
+        for targets, index, mode in ((c, i // (n // 4), 'symbolic'),
+                                     (c2, i % 2, 'evaluated')):
+            result = dr.switch(index, targets, x, mode='adaptive')
+            ref = dr.switch(index, targets, x, mode='evaluated')
+            assert dr.all(result == ref)
+
+            transcript = capsys.readouterr()
+            assert f'-> {mode} mode' in transcript.out + transcript.err
+    finally:
+        dr.set_log_level(level)
+
+# Reordering threads by a coherence key must not change the result
+@pytest.test_arrays('float32,shape=(*),jit')
+def test20_switch_coherence(t):
+    UInt32 = dr.uint32_array_t(t)
+    n = 1000
+    c = [lambda x: x + 1, lambda x: x * 2, lambda x: x - 3]
+
+    x = dr.arange(t, n)
+    i = dr.arange(UInt32, n)
+    index = (i * 7919) % 3
+    key = (i * 2654435761) ^ (i >> 3)
+    active = i % 5 != 0
+
+    ref = dr.switch(index, c, x, active, mode='evaluated')
+    result = dr.switch(index, c, x, active, mode='evaluated', coherence=key)
+    assert dr.all(result == ref)
+
+    # Each function sees its lanes in key order, and lanes with equal keys
+    # keep their original order. Repeating keys (spanning all 32 bits)
+    # create ties.
+    key = (i % 100) * 2654435761
+    pos = lambda x: t(dr.arange(UInt32, dr.width(x)))
+    order = dr.switch(index, [pos] * 3, x, mode='evaluated', coherence=key)
+    index_l, key_l, order_l = list(index), list(key), list(order)
+    for k in range(3):
+        lanes = sorted((j for j in range(n) if index_l[j] == k),
+                       key=lambda j: order_l[j])
+        for a, b in zip(lanes, lanes[1:]):
+            assert key_l[a] < key_l[b] or (key_l[a] == key_l[b] and a < b)
+
+    with pytest.raises(RuntimeError, match='coherence'):
+        dr.switch(index, c, x, mode='evaluated', coherence=x)
+
+
+# Nested targets with per-level indices are flattened into a single switch
+@pytest.mark.parametrize('mode', ['symbolic', 'evaluated'])
+@pytest.test_arrays('float32,shape=(*),jit')
+def test21_switch_nested(t, mode):
+    UInt32 = dr.uint32_array_t(t)
+    targets = [
+        [[lambda x: x + 1], [lambda x: x + 2, lambda x: x + 3]],
+        [[lambda x: x * 2, lambda x: x * 3, lambda x: x * 4]],
+    ]
+
+    i0 = UInt32(0, 0, 0, 1, 1, 1, 0)
+    i1 = UInt32(0, 1, 1, 0, 0, 0, 1)
+    i2 = UInt32(0, 0, 1, 0, 1, 2, 1)
+    x = t(1, 2, 3, 4, 5, 6, 7)
+
+    result = dr.switch((i0, i1, i2), targets, x, mode=mode)
+    assert dr.all(result == t(2, 4, 6, 8, 15, 24, 10))
+
+    # Masked lanes are zero-initialized
+    active = dr.mask_t(t)(True, True, True, True, True, False, False)
+    result = dr.switch((i0, i1, i2), targets, x, active, mode=mode)
+    assert dr.all(result == t(2, 4, 6, 8, 15, 0, 0))
+
+    # Scalar indices
+    assert dr.switch((1, 0, 2), targets, 5) == 20
+
+    # Out-of-bounds indices at any level disable the affected lanes
+    i0 = UInt32(0, 1, 0, 2)
+    i1 = UInt32(0, 1, 1, 0)
+    i2 = UInt32(1, 0, 1, 0)
+    result = dr.switch((i0, i1, i2), targets, t(1, 2, 3, 4), mode=mode)
+    assert dr.all(result == t(0, 0, 6, 0))
+
+    with pytest.raises(RuntimeError, match='Attempted to invoke callable with index 1 at level 1'):
+        dr.switch((1, 1, 0), targets, 5)
@@ -898,3 +898,184 @@ def test26_tensor_getter_does_not_drop_gradient_tracking(t, texture_type, init,
     with dr.suspend_grad():
         tex.tensor() # Might mutate some internal state
     assert dr.grad_enabled(tex.tensor())
+
+
+@pytest.mark.parametrize("texture_type", ['Texture2f64', 'Texture2f'])
+@pytest.test_arrays("is_jit, float32, diff, shape=(*)")
+def test27_mipmap(t, texture_type):
+    mod = sys.modules[t.__module__]
+    TexType = getattr(mod, texture_type)
+    Array2f = getattr(mod, 'Array2f')
+    TensorType = type(TexType([1, 1], 1).tensor())
+
+    tensor = TensorType(dr.arange(t, 16), shape=(4, 4, 1))
+    dr.enable_grad(tensor)
+    tex = TexType(tensor, use_accel=False)
+    tex.build_mipmaps()
+    assert tex.mipmap_levels() == 3
+
+    pos = Array2f(0.25, 0.25)
+
+    # Level 0 matches an ordinary lookup
+    assert dr.allclose(tex.eval_lod(pos, t(0))[0], tex.eval(pos)[0])
+
+    # Level 1 averages 2x2 blocks, level 2 is the mean of the texture
+    assert dr.allclose(tex.eval_lod(pos, t(1))[0], 2.5)
+    assert dr.allclose(tex.eval_lod(pos, t(2))[0], 7.5)
+    assert dr.allclose(tex.eval_lod(pos, t(1.5))[0], 5)
+
+    # A footprint spanning the whole texture selects the coarsest level
+    value = tex.eval_footprint(pos, Array2f(1, 0), Array2f(0, 1))[0]
+    assert dr.allclose(value, 7.5)
+
+    # An anisotropic footprint averages lookups at a finer level
+    value = tex.eval_footprint(Array2f(0.5, 0.25), Array2f(0.5, 0), Array2f(0, 0.25),
+                               max_anisotropy=2)[0]
+    assert dr.allclose(value, 3.5)
+
+    # A degenerate footprint performs a single lookup at the finest level
+    value = tex.eval_footprint(pos, Array2f(0, 0), Array2f(0, 0),
+                               max_anisotropy=2)[0]
+    assert dr.allclose(value, tex.eval(pos)[0])
+
+    # Derivatives propagate through the pyramid
+    value = tex.eval_lod(pos, t(2))[0]
+    dr.backward(value)
+    assert dr.allclose(dr.grad(tensor).array, 1 / 16)
+
+
+@pytest.mark.parametrize("texture_type", ['Texture2f', 'Texture3f'])
+@pytest.mark.parametrize("wrap_mode", wrap_modes)
+@pytest.test_arrays("is_jit, float32, shape=(*)")
+def test28_tiled_layout(t, texture_type, wrap_mode):
+    mod = sys.modules[t.__module__]
+    TexType = getattr(mod, texture_type)
+    dim = int(texture_type[7])
+    ArrayNf = getattr(mod, f'Array{dim}f')
+    TensorType = type(TexType([1] * dim, 1).tensor())
+
+    shape = (5, 7, 3) if dim == 2 else (3, 5, 6, 3)
+    rng = dr.rng(seed=0)
+    tensor = TensorType(rng.random(t, dr.prod(shape)), shape=shape)
+
+    tex_1 = TexType(tensor, use_accel=False, wrap_mode=wrap_mode)
+    tex_2 = TexType(tensor, use_accel=False, wrap_mode=wrap_mode)
+    tex_2.set_layout(dr.TextureLayout.Tiled)
+    assert tex_2.layout() == dr.TextureLayout.Tiled
+
+    # Import and export are unaffected by the layout
+    assert dr.all(tex_2.tensor().array == tensor.array)
+    tex_2.set_tensor(tensor)
+    assert dr.all(tex_2.tensor().array == tensor.array)
+
+    pos = ArrayNf([rng.random(t, 100) * 1.4 - 0.2 for _ in range(dim)])
+    for a, b in zip(tex_1.eval(pos), tex_2.eval(pos)):
+        assert dr.allclose(a, b)
+    for a, b in zip(tex_1.eval_cubic(pos), tex_2.eval_cubic(pos)):
+        assert dr.allclose(a, b)
+
+    tex_2.set_layout(dr.TextureLayout.Linear)
+    for a, b in zip(tex_1.eval(pos), tex_2.eval(pos)):
+        assert dr.allclose(a, b)
+
+
+@pytest.mark.parametrize("channels", [1, 3, 4])
+@pytest.test_arrays("is_jit, float32, diff, shape=(*)")
+def test29_footprint_gather_grad(t, channels):
+    mod = sys.modules[t.__module__]
+    TexType = mod.Texture2f
+    UInt32 = dr.uint32_array_t(t)
+    Int32 = dr.int32_array_t(t)
+
+    shape = (4, 5, channels)
+    rng = dr.rng(seed=0)
+    value = rng.random(t, dr.prod(shape))
+    pos = mod.Array2f(rng.random(t, 50), rng.random(t, 50))
+
+    # Reference: bilinear interpolation written out with scalar gathers
+    def reference(value, pos):
+        px = pos.x * shape[1] - 0.5
+        py = pos.y * shape[0] - 0.5
+        ix, iy = dr.floor(px), dr.floor(py)
+        wx1, wy1 = px - ix, py - iy
+        wx0, wy0 = 1 - wx1, 1 - wy1
+        ix, iy = Int32(ix), Int32(iy)
+        out = [dr.zeros(t, 50) for _ in range(channels)]
+        for dx, dy, w in ((0, 0, wx0 * wy0), (1, 0, wx1 * wy0),
+                          (0, 1, wx0 * wy1), (1, 1, wx1 * wy1)):
+            x = UInt32(dr.clip(ix + dx, 0, shape[1] - 1))
+            y = UInt32(dr.clip(iy + dy, 0, shape[0] - 1))
+            for ch in range(channels):
+                out[ch] += w * dr.gather(t, value,
+                                         (y * shape[1] + x) * channels + ch)
+        return out
+
+    def grads(func):
+        v, p = t(value), mod.Array2f(pos)
+        dr.enable_grad(v, p)
+        tensor = mod.TensorXf(v, shape=shape)
+        out = func(tensor, p)
+        loss = dr.zeros(t, 50)
+        for ch in range(channels):
+            loss += out[ch] * (ch + 1)
+        dr.backward(dr.sum(loss))
+        return out, dr.grad(v), dr.grad(p)
+
+    tex_eval = lambda tensor, p: TexType(tensor, use_accel=False).eval(p)
+    ref_eval = lambda tensor, p: reference(tensor.array, p)
+
+    out_1, dv_1, dp_1 = grads(tex_eval)
+    out_2, dv_2, dp_2 = grads(ref_eval)
+    for a, b in zip(out_1, out_2):
+        assert dr.allclose(a, b)
+    assert dr.allclose(dv_1, dv_2)
+    assert dr.allclose(dp_1, dp_2)
+
+
+@pytest.mark.parametrize("texture_type", ['Texture2f', 'Texture3f'])
+@pytest.mark.parametrize("layout", ['Linear', 'Tiled'])
+@pytest.test_arrays("is_jit, float32, shape=(*)")
+def test30_quantized_format(t, texture_type, layout):
+    mod = sys.modules[t.__module__]
+    TexType = getattr(mod, texture_type)
+    dim = int(texture_type[7])
+    ArrayNf = getattr(mod, f'Array{dim}f')
+    TensorType = type(TexType([1] * dim, 1).tensor())
+
+    shape = (9, 7, 3) if dim == 2 else (3, 5, 6, 3)
+    rng = dr.rng(seed=0)
+    tensor = TensorType(rng.random(t, dr.prod(shape)) * 4 - 2, shape=shape)
+
+    tex_1 = TexType(tensor, use_accel=False)
+    tex_2 = TexType(tensor, use_accel=False)
+    tex_2.set_layout(getattr(dr.TextureLayout, layout))
+    tex_2.set_format(dr.TextureFormat.Quantized8)
+    assert tex_2.format() == dr.TextureFormat.Quantized8
+
+    # The quantization error is bounded by half a step of the value range
+    tol = 4 / 255 * 0.5 + 1e-5
+    assert dr.all(abs(tex_2.tensor().array - tensor.array) <= tol)
+
+    pos = ArrayNf([rng.random(t, 100) for _ in range(dim)])
+    for a, b in zip(tex_1.eval(pos), tex_2.eval(pos)):
+        assert dr.all(abs(a - b) <= tol)
+    for a, b in zip(tex_1.eval_cubic(pos), tex_2.eval_cubic(pos)):
+        assert dr.all(abs(a - b) <= tol)
+
+    # Constant blocks are represented exactly
+    tex_2.set_tensor(dr.full(TensorType, 0.25, shape))
+    assert dr.all(tex_2.eval(pos)[0] == 0.25)
+    assert tex_2.format() == dr.TextureFormat.Quantized8
+
+    tex_2.set_format(dr.TextureFormat.Full)
+    assert dr.all(tex_2.tensor().array == 0.25)
+
+    # Quantizing values attached to the AD graph is an error
+    if dr.is_diff_v(t):
+        dr.enable_grad(tensor)
+        tex_3 = TexType(tensor, use_accel=False)
+        with pytest.raises(RuntimeError, match='not differentiable'):
+            tex_3.set_format(dr.TextureFormat.Quantized8)
+        with pytest.raises(RuntimeError, match='not differentiable'):
+            tex_2.set_format(dr.TextureFormat.Quantized8)
+            tex_2.set_tensor(tensor)
@@ -749,3 +749,74 @@ def test32_loop_with_only_side_effects(t, mode):
         i += 1
 
     assert dr.allclose(result, [20, 10, 20, 0, 10])
+
+
+# Compression policies must not change the result of compressed loops
+@pytest.mark.parametrize('policy', ['Always', 'Threshold', 'Interval', 'CostModel'])
+@pytest.test_arrays('uint32,is_jit,shape=(*)')
+def test33_compress_policy(t, policy):
+    label = f'test33_{policy}'
+    dr.set_compress_policy(label, getattr(dr.CompressPolicy, policy))
+    dr.loop_stats_clear()
+
+    try:
+        i = dr.arange(t, 1000)
+        n = i % 37
+        value = t(0)
+
+        n, value = dr.while_loop(
+            state=(n, value),
+            cond=lambda n, value: n > 0,
+            body=lambda n, value: (n - 1, value + n),
+            mode='evaluated',
+            compress=True,
+            label=label
+        )
+
+        ref = (i % 37) * (i % 37 + 1) // 2
+        assert dr.all(value == ref) and dr.all(n == 0)
+
+        stats = dr.loop_stats(label)
+        assert stats['iterations'] == 36
+        assert len(stats['active_fraction']) == 36
+        assert abs(stats['active_fraction'][0] - 0.972) < 1e-6
+        assert stats['compressions'] >= 1 and stats['bytes_moved'] > 0
+        if policy == 'Always':
+            assert stats['compressions'] == 37
+        elif policy != 'CostModel':
+            assert stats['compressions'] < 37
+    finally:
+        dr.set_compress_policy(label, dr.CompressPolicy.Always)
+
+
+# Executing several iterations per kernel launch must not change the result
+@pytest.mark.parametrize('iterations', [1, 3, 8])
+@pytest.test_arrays('float32,is_diff,shape=(*)')
+def test34_persistent_iterations(t, iterations):
+    UInt32 = dr.uint32_array_t(t)
+    label = f'test34_{iterations}'
+    dr.set_persistent_iterations(label, iterations)
+
+    try:
+        x = t(1, 2, 3, 4)
+        dr.enable_grad(x)
+        n = UInt32(0, 2, 5, 11)
+        y = t(x)
+
+        n, y = dr.while_loop(
+            state=(n, y),
+            cond=lambda n, y: n > 0,
+            body=lambda n, y: (n - 1, y * 1.5),
+            mode='evaluated',
+            compress=False,
+            label=label
+        )
+
+        ref = [1.5**k for k in (0, 2, 5, 11)]
+        assert dr.allclose(y, dr.detach(x) * ref)
+        assert dr.all(n == 0)
+
+        dr.backward(y)
+        assert dr.allclose(x.grad, ref)
+    finally:
+        dr.set_persistent_iterations(label, 1)